@@ -519,6 +519,16 @@ void Batcher::SetTimeoutMillis(int millis) {
   timeout_ = MonoDelta::FromMilliseconds(millis);
 }
 
+void Batcher::SetMaxBufferSize(int64_t bytes) {
+  CHECK_GT(bytes, 0);
+  CHECK_EQ(buffer_bytes_used_.Load(), 0) << "Cannot resize a non-empty buffer";
+  max_buffer_size_ = bytes;
+}
+
+int64_t Batcher::buffer_bytes_used() const {
+  return buffer_bytes_used_.Load();
+}
+
 
 bool Batcher::HasPendingOperations() const {
   lock_guard<simple_spinlock> l(&lock_);
@@ -640,6 +650,65 @@ Status Batcher::Add(KuduWriteOperation* write_op) {
   return Status::OK();
 }
 
+Status Batcher::Add(const vector<KuduWriteOperation*>& write_ops) {
+  int64_t required_size = 0;
+  BOOST_FOREACH(KuduWriteOperation* write_op, write_ops) {
+    required_size += write_op->SizeInBuffer();
+  }
+  int64_t size_after_adding = buffer_bytes_used_.IncrementBy(required_size);
+  if (PREDICT_FALSE(size_after_adding > max_buffer_size_)) {
+    buffer_bytes_used_.IncrementBy(-required_size);
+    int64_t size_before_adding = size_after_adding - required_size;
+    return Status::Incomplete(Substitute(
+        "not enough space remaining in buffer for ops (required $0, "
+        "$1 already used",
+        HumanReadableNumBytes::ToString(required_size),
+        HumanReadableNumBytes::ToString(size_before_adding)));
+  }
+
+  // Encode all of the partition keys up front. This is the only step which
+  // can fail, and doing it before taking ownership of any op keeps the
+  // failure contract simple.
+  vector<InFlightOp*> ops;
+  ElementDeleter deleter(&ops);
+  ops.reserve(write_ops.size());
+  BOOST_FOREACH(KuduWriteOperation* write_op, write_ops) {
+    gscoped_ptr<InFlightOp> op(new InFlightOp());
+    Status s = write_op->table_->partition_schema()
+        .EncodeKey(write_op->row(), &op->partition_key);
+    if (PREDICT_FALSE(!s.ok())) {
+      buffer_bytes_used_.IncrementBy(-required_size);
+      return s;
+    }
+    ops.push_back(op.release());
+  }
+
+  for (int i = 0; i < static_cast<int>(ops.size()); i++) {
+    ops[i]->write_op.reset(write_ops[i]);
+    ops[i]->state = InFlightOp::kLookingUpTablet;
+  }
+
+  // A single lock acquisition covers the whole group.
+  AddInFlightOps(ops);
+
+  MonoTime deadline = ComputeDeadlineUnlocked();
+  BOOST_FOREACH(InFlightOp* op, ops) {
+    VLOG(3) << "Looking up tablet for " << op->write_op->ToString();
+
+    // Increment our reference count for the outstanding callback.
+    base::RefCountInc(&outstanding_lookups_);
+    client_->data_->meta_cache_->LookupTabletByKey(
+        op->write_op->table(),
+        op->partition_key,
+        deadline,
+        &op->tablet,
+        Bind(&Batcher::TabletLookupFinished, this, op));
+  }
+  // Ownership has passed to the in-flight set and the lookup callbacks.
+  ops.clear();
+  return Status::OK();
+}
+
 void Batcher::AddInFlightOp(InFlightOp* op) {
   DCHECK_EQ(op->state, InFlightOp::kLookingUpTablet);
 
@@ -649,6 +718,16 @@ void Batcher::AddInFlightOp(InFlightOp* op) {
   op->sequence_number_ = next_op_sequence_number_++;
 }
 
+void Batcher::AddInFlightOps(const vector<InFlightOp*>& ops) {
+  lock_guard<simple_spinlock> l(&lock_);
+  CHECK_EQ(state_, kGatheringOps);
+  BOOST_FOREACH(InFlightOp* op, ops) {
+    DCHECK_EQ(op->state, InFlightOp::kLookingUpTablet);
+    InsertOrDie(&ops_, op);
+    op->sequence_number_ = next_op_sequence_number_++;
+  }
+}
+
 bool Batcher::IsAbortedUnlocked() const {
   return state_ == kAborted;
 }
@@ -803,11 +882,15 @@ void Batcher::ProcessWriteResponse(const WriteRpc& rpc,
       client_->data_->UpdateLatestObservedTimestamp(rpc.resp().timestamp());
     }
   } else {
-    // Mark each of the rows in the write op as failed, since the whole RPC failed.
+    // Mark each of the rows in the write op as failed, since the whole RPC
+    // failed. Hand the errors to the collector in one batch rather than one
+    // at a time, so its lock is only taken once.
+    vector<KuduError*> errors;
+    errors.reserve(rpc.ops().size());
     BOOST_FOREACH(InFlightOp* op, rpc.ops()) {
-      gscoped_ptr<KuduError> error(new KuduError(op->write_op.release(), s));
-      error_collector_->AddError(error.Pass());
+      errors.push_back(new KuduError(op->write_op.release(), s));
     }
+    error_collector_->AddErrors(&errors);
 
     MarkHadErrors();
   }
@@ -75,6 +75,15 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // may time out before even sending an op). TODO: implement that
   void SetTimeoutMillis(int millis);
 
+  // Set the maximum amount of buffer space, in bytes, that this batcher will
+  // accept before Add() starts returning Status::Incomplete. May only be
+  // called before any operations have been added.
+  void SetMaxBufferSize(int64_t bytes);
+
+  // Return the number of bytes of buffer space currently consumed by
+  // buffered operations.
+  int64_t buffer_bytes_used() const;
+
   // Add a new operation to the batch. Requires that the batch has not yet been flushed.
   // TODO: in other flush modes, this may not be the case -- need to
   // update this when they're implemented.
@@ -82,6 +91,13 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // NOTE: If this returns not-OK, does not take ownership of 'write_op'.
   Status Add(KuduWriteOperation* write_op) WARN_UNUSED_RESULT;
 
+  // Add a group of operations to the batch in a single call. Equivalent to
+  // calling Add() on each operation in turn, except that the batcher's lock
+  // is taken once for the whole group rather than once per operation.
+  //
+  // NOTE: if this returns not-OK, does not take ownership of any of the ops.
+  Status Add(const std::vector<KuduWriteOperation*>& write_ops) WARN_UNUSED_RESULT;
+
   // Return true if any operations are still pending. An operation is no longer considered
   // pending once it has either errored or succeeded.  Operations are considering pending
   // as soon as they are added, even if Flush has not been called.
@@ -107,6 +123,9 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // Add an op to the in-flight set and increment the ref-count.
   void AddInFlightOp(InFlightOp* op);
 
+  // Add a group of ops to the in-flight set, taking the lock only once.
+  void AddInFlightOps(const std::vector<InFlightOp*>& ops);
+
   void RemoveInFlightOp(InFlightOp* op);
 
   // Return true if the batch has been aborted, and any in-flight ops should stop
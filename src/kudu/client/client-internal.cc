@@ -268,16 +268,35 @@ RemoteTabletServer* KuduClient::Data::SelectTServer(const scoped_refptr<RemoteTa
           ret = filtered[0];
         }
       } else if (selection == CLOSEST_REPLICA) {
-        // Choose a local replica.
+        // Rank the replicas by distance: a local replica is at distance
+        // zero, a remote replica with a smoothed RPC round-trip estimate
+        // (see RemoteTabletServer::RecordRpcRtt()) is at that distance,
+        // and a remote replica that has never been timed sorts last.
+        // Replicas within 25% of the nearest are considered equidistant
+        // and chosen between at random, so that equally-close replicas
+        // share the scan load.
+        static const double kUnmeasuredDistanceUs = 1e12;
+        vector<double> distances;
+        double min_distance = kUnmeasuredDistanceUs;
         BOOST_FOREACH(RemoteTabletServer* rts, filtered) {
+          double distance;
           if (IsTabletServerLocal(*rts)) {
-            ret = rts;
-            break;
+            distance = 0;
+          } else {
+            double estimate = rts->rtt_estimate_us();
+            distance = estimate >= 0 ? estimate : kUnmeasuredDistanceUs;
           }
+          distances.push_back(distance);
+          min_distance = std::min(min_distance, distance);
         }
-        // Fallback to a random replica if none are local.
-        if (ret == NULL && !filtered.empty()) {
-          ret = filtered[rand() % filtered.size()];
+        vector<RemoteTabletServer*> nearest;
+        for (size_t i = 0; i < filtered.size(); i++) {
+          if (distances[i] <= min_distance * 1.25) {
+            nearest.push_back(filtered[i]);
+          }
+        }
+        if (!nearest.empty()) {
+          ret = nearest[rand() % nearest.size()];
         }
       }
       break;
@@ -700,6 +719,7 @@ void GetTableSchemaRpc::SendRpcCb(const Status& status) {
     LOG(WARNING) << ToString() << " failed: " << new_status.ToString();
   }
   user_cb_.Run(new_status);
+  delete this;
 }
 
 } // namespace internal
@@ -711,18 +731,35 @@ Status KuduClient::Data::GetTableSchema(KuduClient* client,
                                         PartitionSchema* partition_schema,
                                         string* table_id) {
   Synchronizer sync;
-  GetTableSchemaRpc rpc(client,
-                        sync.AsStatusCallback(),
-                        table_name,
-                        schema,
-                        partition_schema,
-                        table_id,
-                        deadline,
-                        messenger_);
-  rpc.SendRpc();
+  GetTableSchemaAsync(client,
+                      table_name,
+                      deadline,
+                      schema,
+                      partition_schema,
+                      table_id,
+                      sync.AsStatusCallback());
   return sync.Wait();
 }
 
+void KuduClient::Data::GetTableSchemaAsync(KuduClient* client,
+                                           const string& table_name,
+                                           const MonoTime& deadline,
+                                           KuduSchema* schema,
+                                           PartitionSchema* partition_schema,
+                                           string* table_id,
+                                           const StatusCallback& callback) {
+  // The RPC cleans itself up after running 'callback'.
+  GetTableSchemaRpc* rpc = new GetTableSchemaRpc(client,
+                                                 callback,
+                                                 table_name,
+                                                 schema,
+                                                 partition_schema,
+                                                 table_id,
+                                                 deadline,
+                                                 messenger_);
+  rpc->SendRpc();
+}
+
 void KuduClient::Data::LeaderMasterDetermined(const Status& status,
                                               const HostPort& host_port) {
   Sockaddr leader_sock_addr;
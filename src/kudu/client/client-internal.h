@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "kudu/client/client.h"
+#include "kudu/common/partition.h"
 #include "kudu/util/atomic.h"
 #include "kudu/util/locks.h"
 #include "kudu/util/monotime.h"
@@ -44,6 +45,32 @@ class RpcController;
 
 namespace client {
 
+namespace internal {
+
+// State for an in-flight KuduClient::OpenTableAsync() call. Holds the
+// outputs of the schema lookup until the RPC completes and the table can
+// be constructed.
+struct OpenTableAsyncState {
+  OpenTableAsyncState(const std::string& table_name,
+                      std::tr1::shared_ptr<KuduTable>* table,
+                      KuduStatusCallback* callback)
+    : table_name(table_name),
+      table(table),
+      callback(callback) {
+  }
+
+  const std::string table_name;
+  KuduSchema schema;
+  PartitionSchema partition_schema;
+  std::string table_id;
+
+  // Both owned by the caller of OpenTableAsync().
+  std::tr1::shared_ptr<KuduTable>* table;
+  KuduStatusCallback* callback;
+};
+
+} // namespace internal
+
 class KuduClient::Data {
  public:
   Data();
@@ -102,6 +129,17 @@ class KuduClient::Data {
                         PartitionSchema* partition_schema,
                         std::string* table_id);
 
+  // Asynchronous version of GetTableSchema() above. 'callback' is invoked
+  // with the result once the lookup completes, possibly on a reactor
+  // thread. The out-parameters must remain valid until then.
+  void GetTableSchemaAsync(KuduClient* client,
+                           const std::string& table_name,
+                           const MonoTime& deadline,
+                           KuduSchema* schema,
+                           PartitionSchema* partition_schema,
+                           std::string* table_id,
+                           const StatusCallback& callback);
+
   Status InitLocalHostNames();
 
   bool IsLocalHostPort(const HostPort& hp) const;
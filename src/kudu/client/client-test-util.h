@@ -28,6 +28,15 @@ class Schema;
 namespace client {
 class KuduSchema;
 
+// Grants test code access to the private state of the public client
+// classes. client.h friends this single class instead of individual test
+// cases, so the public header needs no test-framework macros.
+class ClientTestAccessor {
+ public:
+  static KuduClient::Data* data(KuduClient* client) { return client->data_; }
+  static KuduScanner::Data* data(KuduScanner* scanner) { return scanner->data_; }
+};
+
 // Log any pending errors in the given session, and then crash the current
 // process.
 void LogSessionErrorsAndDie(const std::tr1::shared_ptr<KuduSession>& session,
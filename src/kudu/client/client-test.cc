@@ -26,9 +26,12 @@
 #include "kudu/client/client.h"
 #include "kudu/client/client-internal.h"
 #include "kudu/client/client-test-util.h"
+#include "kudu/client/columnar_batch.h"
 #include "kudu/client/meta_cache.h"
 #include "kudu/client/row_result.h"
+#include "kudu/client/scan_batch.h"
 #include "kudu/client/scanner-internal.h"
+#include "kudu/client/typed_table.h"
 #include "kudu/client/value.h"
 #include "kudu/client/write_op.h"
 #include "kudu/common/partial_row.h"
@@ -51,6 +54,7 @@
 #include "kudu/tserver/scanners.h"
 #include "kudu/tserver/tablet_server.h"
 #include "kudu/tserver/ts_tablet_manager.h"
+#include "kudu/util/bitmap.h"
 #include "kudu/util/metrics.h"
 #include "kudu/util/net/sockaddr.h"
 #include "kudu/util/status.h"
@@ -493,7 +497,7 @@ TEST_F(ClientTest, TestBadTable) {
 TEST_F(ClientTest, TestMasterDown) {
   cluster_->mini_master()->Shutdown();
   shared_ptr<KuduTable> t;
-  client_->data_->default_admin_operation_timeout_ = MonoDelta::FromSeconds(1);
+  ClientTestAccessor::data(client_.get())->default_admin_operation_timeout_ = MonoDelta::FromSeconds(1);
   Status s = client_->OpenTable("other-tablet", &t);
   ASSERT_TRUE(s.IsNetworkError());
 }
@@ -709,6 +713,63 @@ TEST_F(ClientTest, TestScanMultiTablet) {
   ASSERT_EQ(0, CountRowsFromClient(table.get(), 50, kNoBound));
 }
 
+TEST_F(ClientTest, TestMultiScanner) {
+  // 5 tablets, 10 rows each.
+  vector<const KuduPartialRow*> rows;
+  for (int i = 1; i < 5; i++) {
+    KuduPartialRow* row = schema_.NewRow();
+    CHECK_OK(row->SetInt32(0, i * 10));
+    rows.push_back(row);
+  }
+  gscoped_ptr<KuduTableCreator> table_creator(client_->NewTableCreator());
+  ASSERT_OK(table_creator->table_name("TestMultiScanner")
+            .schema(&schema_)
+            .split_rows(rows)
+            .Create());
+
+  shared_ptr<KuduTable> table;
+  ASSERT_OK(client_->OpenTable("TestMultiScanner", &table));
+  const int kNumRows = 50;
+  ASSERT_NO_FATAL_FAILURE(InsertTestRows(table.get(), kNumRows));
+
+  // Scan the whole table; every row should be returned exactly once.
+  {
+    KuduMultiScanner scanner(table.get());
+    ASSERT_OK(scanner.Open());
+    vector<bool> seen(kNumRows, false);
+    KuduScanBatch batch;
+    while (scanner.HasMoreRows()) {
+      ASSERT_OK(scanner.NextBatch(&batch));
+      for (int i = 0; i < batch.NumRows(); i++) {
+        int32_t key;
+        ASSERT_OK(batch.Row(i).GetInt32(0, &key));
+        ASSERT_FALSE(seen[key]) << "Duplicate row " << key;
+        seen[key] = true;
+      }
+    }
+    for (int i = 0; i < kNumRows; i++) {
+      ASSERT_TRUE(seen[i]) << "Missing row " << i;
+    }
+  }
+
+  // Scan with a predicate and fewer workers than tablets.
+  {
+    KuduMultiScanner scanner(table.get());
+    ASSERT_OK(scanner.SetMaxConcurrentTablets(2));
+    ASSERT_OK(scanner.AddConjunctPredicate(
+                  table->NewComparisonPredicate("key", KuduPredicate::GREATER_EQUAL,
+                                                KuduValue::FromInt(25))));
+    ASSERT_OK(scanner.Open());
+    int count = 0;
+    KuduScanBatch batch;
+    while (scanner.HasMoreRows()) {
+      ASSERT_OK(scanner.NextBatch(&batch));
+      count += batch.NumRows();
+    }
+    ASSERT_EQ(kNumRows - 25, count);
+  }
+}
+
 TEST_F(ClientTest, TestScanEmptyTable) {
   KuduScanner scanner(client_table_.get());
   ASSERT_OK(scanner.SetProjectedColumns(vector<string>()));
@@ -746,6 +807,82 @@ TEST_F(ClientTest, TestScanEmptyProjection) {
   }
 }
 
+TEST_F(ClientTest, TestScanWithScanBatch) {
+  const int kNumRows = 1000;
+  ASSERT_NO_FATAL_FAILURE(InsertTestRows(client_table_.get(), kNumRows));
+
+  KuduScanner scanner(client_table_.get());
+  ASSERT_OK(scanner.Open());
+
+  KuduScanBatch batch;
+  int total_rows = 0;
+  while (scanner.HasMoreRows()) {
+    ASSERT_OK(scanner.NextBatch(&batch));
+    ASSERT_EQ(batch.NumRows() == 0, batch.data() == NULL);
+    for (int i = 0; i < batch.NumRows(); i++) {
+      int32_t key;
+      int32_t int_val;
+      ASSERT_OK(batch.Row(i).GetInt32(0, &key));
+      ASSERT_OK(batch.Row(i).GetInt32(1, &int_val));
+      ASSERT_EQ(key * 2, int_val);
+    }
+    total_rows += batch.NumRows();
+  }
+  ASSERT_EQ(kNumRows, total_rows);
+}
+
+TEST_F(ClientTest, TestScanColumnarBatch) {
+  const int kNumRows = 100;
+  ASSERT_NO_FATAL_FAILURE(InsertTestRows(client_table_.get(), kNumRows));
+
+  // Add one row with a NULL string_val to exercise the null bitmap.
+  shared_ptr<KuduSession> session = client_->NewSession();
+  ASSERT_OK(session->SetFlushMode(KuduSession::MANUAL_FLUSH));
+  gscoped_ptr<KuduInsert> insert(client_table_->NewInsert());
+  ASSERT_OK(insert->mutable_row()->SetInt32(0, kNumRows));
+  ASSERT_OK(insert->mutable_row()->SetInt32(1, kNumRows * 2));
+  ASSERT_OK(insert->mutable_row()->SetNull(2));
+  ASSERT_OK(insert->mutable_row()->SetInt32(3, kNumRows * 3));
+  ASSERT_OK(session->Apply(insert.release()));
+  FlushSessionOrDie(session);
+
+  KuduScanner scanner(client_table_.get());
+  ASSERT_OK(scanner.SetProjectedColumns(
+      list_of<string>("key")("int_val")("string_val")));
+  ASSERT_OK(scanner.Open());
+
+  KuduColumnarBatch batch;
+  int total_rows = 0;
+  while (scanner.HasMoreRows()) {
+    ASSERT_OK(scanner.NextBatchColumnar(&batch));
+    ASSERT_EQ(3, batch.num_columns());
+    int n = batch.num_rows();
+    ASSERT_EQ(n * sizeof(int32_t), batch.column_data(0).size());
+    ASSERT_EQ(n * sizeof(Slice), batch.column_data(2).size());
+    const int32_t* keys =
+        reinterpret_cast<const int32_t*>(batch.column_data(0).data());
+    const int32_t* int_vals =
+        reinterpret_cast<const int32_t*>(batch.column_data(1).data());
+    const Slice* strings =
+        reinterpret_cast<const Slice*>(batch.column_data(2).data());
+    ASSERT_TRUE(batch.null_bitmap(0) == NULL);
+    const uint8_t* nulls = batch.null_bitmap(2);
+    ASSERT_TRUE(nulls != NULL);
+    for (int i = 0; i < n; i++) {
+      int32_t key = keys[i];
+      ASSERT_EQ(key * 2, int_vals[i]);
+      if (key == kNumRows) {
+        ASSERT_TRUE(BitmapTest(nulls, i));
+      } else {
+        ASSERT_FALSE(BitmapTest(nulls, i));
+        ASSERT_EQ(StringPrintf("hello %d", key), strings[i].ToString());
+      }
+    }
+    total_rows += n;
+  }
+  ASSERT_EQ(kNumRows + 1, total_rows);
+}
+
 TEST_F(ClientTest, TestProjectInvalidColumn) {
   KuduScanner scanner(client_table_.get());
   Status s = scanner.SetProjectedColumns(list_of<string>("column-doesnt-exist"));
@@ -879,7 +1016,7 @@ TEST_F(ClientTest, TestScanCloseProxy) {
     KuduScanner scanner(table.get());
     ASSERT_OK(scanner.Open());
     scanner.Close();
-    CHECK_EQ(0, scanner.data_->proxy_.use_count()) << "Proxy was not reset!";
+    CHECK_EQ(0, ClientTestAccessor::data(&scanner)->proxy_.use_count()) << "Proxy was not reset!";
   }
 
   // Insert some test rows.
@@ -890,7 +1027,7 @@ TEST_F(ClientTest, TestScanCloseProxy) {
     KuduScanner scanner(table.get());
     ASSERT_OK(scanner.Open());
     scanner.Close();
-    CHECK_EQ(0, scanner.data_->proxy_.use_count()) << "Proxy was not reset!";
+    CHECK_EQ(0, ClientTestAccessor::data(&scanner)->proxy_.use_count()) << "Proxy was not reset!";
   }
 }
 
@@ -1033,7 +1170,7 @@ TEST_F(ClientTest, TestGetTabletServerBlacklist) {
   scoped_refptr<internal::RemoteTablet> rt;
   while (true) {
     Synchronizer sync;
-    client_->data_->meta_cache_->LookupTabletByKey(table.get(), "", MonoTime::Max(), &rt,
+    ClientTestAccessor::data(client_.get())->meta_cache_->LookupTabletByKey(table.get(), "", MonoTime::Max(), &rt,
                                                   sync.AsStatusCallback());
     ASSERT_OK(sync.Wait());
     ASSERT_TRUE(rt.get() != NULL);
@@ -1051,25 +1188,25 @@ TEST_F(ClientTest, TestGetTabletServerBlacklist) {
   set<string> blacklist;
   vector<internal::RemoteTabletServer*> candidates;
   vector<internal::RemoteTabletServer*> tservers;
-  ASSERT_OK(client_->data_->GetTabletServer(client_.get(), rt->tablet_id(),
+  ASSERT_OK(ClientTestAccessor::data(client_.get())->GetTabletServer(client_.get(), rt->tablet_id(),
                                             KuduClient::LEADER_ONLY,
                                             blacklist, &candidates, &rts));
   tservers.push_back(rts);
   // Blacklist the leader, should not work.
   blacklist.insert(rts->permanent_uuid());
   {
-    Status s = client_->data_->GetTabletServer(client_.get(), rt->tablet_id(),
+    Status s = ClientTestAccessor::data(client_.get())->GetTabletServer(client_.get(), rt->tablet_id(),
                                                KuduClient::LEADER_ONLY,
                                                blacklist, &candidates, &rts);
     ASSERT_TRUE(s.IsServiceUnavailable());
   }
   // Keep blacklisting replicas until we run out.
-  ASSERT_OK(client_->data_->GetTabletServer(client_.get(), rt->tablet_id(),
+  ASSERT_OK(ClientTestAccessor::data(client_.get())->GetTabletServer(client_.get(), rt->tablet_id(),
                                             KuduClient::CLOSEST_REPLICA,
                                             blacklist, &candidates, &rts));
   tservers.push_back(rts);
   blacklist.insert(rts->permanent_uuid());
-  ASSERT_OK(client_->data_->GetTabletServer(client_.get(), rt->tablet_id(),
+  ASSERT_OK(ClientTestAccessor::data(client_.get())->GetTabletServer(client_.get(), rt->tablet_id(),
                                             KuduClient::FIRST_REPLICA,
                                             blacklist, &candidates, &rts));
   tservers.push_back(rts);
@@ -1081,22 +1218,35 @@ TEST_F(ClientTest, TestGetTabletServerBlacklist) {
   selections.push_back(KuduClient::CLOSEST_REPLICA);
   selections.push_back(KuduClient::FIRST_REPLICA);
   BOOST_FOREACH(KuduClient::ReplicaSelection selection, selections) {
-    Status s = client_->data_->GetTabletServer(client_.get(), rt->tablet_id(), selection,
+    Status s = ClientTestAccessor::data(client_.get())->GetTabletServer(client_.get(), rt->tablet_id(), selection,
                                                blacklist, &candidates, &rts);
     ASSERT_TRUE(s.IsServiceUnavailable());
   }
 
   // Make sure none of the modes work when all nodes are dead.
   BOOST_FOREACH(internal::RemoteTabletServer* rt, tservers) {
-    client_->data_->meta_cache_->MarkTSFailed(rt, Status::NetworkError("test"));
+    ClientTestAccessor::data(client_.get())->meta_cache_->MarkTSFailed(rt, Status::NetworkError("test"));
   }
   blacklist.clear();
   BOOST_FOREACH(KuduClient::ReplicaSelection selection, selections) {
-    Status s = client_->data_->GetTabletServer(client_.get(), rt->tablet_id(),
+    Status s = ClientTestAccessor::data(client_.get())->GetTabletServer(client_.get(), rt->tablet_id(),
                                                selection,
                                                blacklist, &candidates, &rts);
     ASSERT_TRUE(s.IsServiceUnavailable());
   }
+
+  // The failure marking is only a hint: once the replicas are looked up from
+  // the master again, the servers should be usable again.
+  rt->InvalidateCachedReplicas();
+  {
+    Synchronizer sync;
+    ClientTestAccessor::data(client_.get())->meta_cache_->LookupTabletByKey(table.get(), "", MonoTime::Max(), &rt,
+                                                   sync.AsStatusCallback());
+    ASSERT_OK(sync.Wait());
+  }
+  tservers.clear();
+  rt->GetRemoteTabletServers(&tservers);
+  ASSERT_EQ(3, tservers.size());
 }
 
 TEST_F(ClientTest, TestScanWithEncodedRangePredicate) {
@@ -1334,12 +1484,12 @@ TEST_F(ClientTest, TestScanTimeout) {
   // If we set the RPC timeout to be 0, we'll time out in the GetTableLocations
   // code path and not even discover where the tablet is hosted.
   {
-    client_->data_->default_rpc_timeout_ = MonoDelta::FromSeconds(0);
+    ClientTestAccessor::data(client_.get())->default_rpc_timeout_ = MonoDelta::FromSeconds(0);
     KuduScanner scanner(client_table_.get());
     Status s = scanner.Open();
     EXPECT_TRUE(s.IsTimedOut()) << s.ToString();
-    EXPECT_FALSE(scanner.data_->remote_) << "should not have located any tablet";
-    client_->data_->default_rpc_timeout_ = MonoDelta::FromSeconds(5);
+    EXPECT_FALSE(ClientTestAccessor::data(&scanner)->remote_) << "should not have located any tablet";
+    ClientTestAccessor::data(client_.get())->default_rpc_timeout_ = MonoDelta::FromSeconds(5);
   }
 
   // Warm the cache so that the subsequent timeout occurs within the scan,
@@ -1351,13 +1501,13 @@ TEST_F(ClientTest, TestScanTimeout) {
     KuduScanner scanner(client_table_.get());
     ASSERT_OK(scanner.SetTimeoutMillis(0));
     ASSERT_TRUE(scanner.Open().IsTimedOut());
-    ASSERT_TRUE(scanner.data_->remote_) << "We should have located a tablet";
-    ASSERT_EQ(0, scanner.data_->remote_->GetNumFailedReplicas());
+    ASSERT_TRUE(ClientTestAccessor::data(&scanner)->remote_) << "We should have located a tablet";
+    ASSERT_EQ(0, ClientTestAccessor::data(&scanner)->remote_->GetNumFailedReplicas());
   }
 
   // Insert some more rows so that the scan takes multiple batches, instead of
   // fetching all the data on the 'Open()' call.
-  client_->data_->default_rpc_timeout_ = MonoDelta::FromSeconds(5);
+  ClientTestAccessor::data(client_.get())->default_rpc_timeout_ = MonoDelta::FromSeconds(5);
   ASSERT_NO_FATAL_FAILURE(InsertTestRows(client_table_.get(), 1000, 1));
   {
     google::FlagSaver saver;
@@ -1368,7 +1518,7 @@ TEST_F(ClientTest, TestScanTimeout) {
     // table, we'll ignore this timeout for the actual scan calls, and use the
     // scanner timeout instead.
     FLAGS_scanner_inject_latency_on_each_batch_ms = 50;
-    client_->data_->default_rpc_timeout_ = MonoDelta::FromMilliseconds(1);
+    ClientTestAccessor::data(client_.get())->default_rpc_timeout_ = MonoDelta::FromMilliseconds(1);
     scanner.SetTimeoutMillis(5000);
 
     // Should successfully scan.
@@ -1396,6 +1546,25 @@ static gscoped_ptr<KuduError> GetSingleErrorFromSession(KuduSession* session) {
 
 // Simplest case of inserting through the client API: a single row
 // with manual batching.
+// Write ops allocate their row storage in-line with the op itself.
+// Assigning over the row swaps in separately-owned storage; make sure the
+// op remains usable and the copied values survive the source op.
+TEST_F(ClientTest, TestWriteOpRowAssignment) {
+  gscoped_ptr<KuduInsert> dst(client_table_->NewInsert());
+  gscoped_ptr<KuduInsert> src(client_table_->NewInsert());
+  ASSERT_OK(src->mutable_row()->SetInt32("key", 12345));
+  ASSERT_OK(src->mutable_row()->SetStringCopy("string_val", "hello world"));
+  *dst->mutable_row() = src->row();
+  src.reset();
+
+  int32_t key;
+  ASSERT_OK(dst->row().GetInt32("key", &key));
+  ASSERT_EQ(12345, key);
+  Slice string_val;
+  ASSERT_OK(dst->row().GetString("string_val", &string_val));
+  ASSERT_EQ("hello world", string_val.ToString());
+}
+
 TEST_F(ClientTest, TestInsertSingleRowManualBatch) {
   shared_ptr<KuduSession> session = client_->NewSession();
   ASSERT_FALSE(session->HasPendingOperations());
@@ -1429,6 +1598,59 @@ TEST_F(ClientTest, TestInsertSingleRowManualBatch) {
   FlushSessionOrDie(session);
 }
 
+// Insert a group of rows through ApplyBatch() rather than one
+// Apply() call per row.
+TEST_F(ClientTest, TestTypedTableInsert) {
+  shared_ptr<KuduSession> session = client_->NewSession();
+  ASSERT_OK(session->SetFlushMode(KuduSession::MANUAL_FLUSH));
+  session->SetTimeoutMillis(10000);
+
+  KuduTypedTable<int32_t, int32_t, Slice, int32_t> typed(client_table_.get());
+  ASSERT_OK(typed.init_status());
+
+  const int kNumRows = 100;
+  for (int i = 0; i < kNumRows; i++) {
+    ASSERT_OK(typed.Insert(session.get(), i, i * 2,
+                           Slice(StringPrintf("hello %d", i)), i * 3));
+  }
+  FlushSessionOrDie(session);
+  ASSERT_EQ(kNumRows, CountRowsFromClient(client_table_.get()));
+
+  // A template argument list which doesn't match the table's schema is
+  // detected at construction time.
+  KuduTypedTable<int64_t> mismatched(client_table_.get());
+  ASSERT_TRUE(mismatched.init_status().IsInvalidArgument());
+}
+
+TEST_F(ClientTest, TestInsertBatchedApply) {
+  shared_ptr<KuduSession> session = client_->NewSession();
+  ASSERT_OK(session->SetFlushMode(KuduSession::MANUAL_FLUSH));
+
+  const int kNumRows = 100;
+  vector<KuduWriteOperation*> ops;
+  ElementDeleter d(&ops);
+  for (int i = 0; i < kNumRows; i++) {
+    ops.push_back(BuildTestRow(client_table_.get(), i).release());
+  }
+  ASSERT_OK(session->ApplyBatch(&ops));
+  ASSERT_TRUE(ops.empty()) << "Successful ApplyBatch should take ownership";
+  ASSERT_TRUE(session->HasPendingOperations()) << "Should be pending until we Flush";
+  FlushSessionOrDie(session);
+  ASSERT_EQ(kNumRows, CountRowsFromClient(client_table_.get()));
+
+  // A batch containing an op with no key set should fail up front and
+  // leave ownership of all of the ops with the caller.
+  ops.push_back(BuildTestRow(client_table_.get(), kNumRows).release());
+  gscoped_ptr<KuduInsert> bad_insert(client_table_->NewInsert());
+  ASSERT_OK(bad_insert->mutable_row()->SetInt32("int_val", 54321));
+  ops.push_back(bad_insert.release());
+  Status s = session->ApplyBatch(&ops);
+  ASSERT_TRUE(s.IsIllegalState());
+  ASSERT_EQ(2, ops.size());
+  ASSERT_EQ(0, session->CountPendingErrors());
+  ASSERT_FALSE(session->HasPendingOperations());
+}
+
 static Status ApplyInsertToSession(KuduSession* session,
                                    const shared_ptr<KuduTable>& table,
                                    int row_key,
@@ -1459,6 +1681,30 @@ static Status ApplyDeleteToSession(KuduSession* session,
   return session->Apply(del.release());
 }
 
+// Write through a session left in its default flush mode
+// (AUTO_FLUSH_SYNC), where every Apply() and ApplyBatch() call flushes
+// in-band. Deliberately never calls SetFlushMode().
+TEST_F(ClientTest, TestAutoFlushSyncApply) {
+  shared_ptr<KuduSession> session = client_->NewSession();
+  session->SetTimeoutMillis(10000);
+
+  ASSERT_OK(ApplyInsertToSession(session.get(), client_table_, 0, 0, "row"));
+  ASSERT_FALSE(session->HasPendingOperations());
+  ASSERT_EQ(1, CountRowsFromClient(client_table_.get()));
+
+  const int kNumRows = 10;
+  vector<KuduWriteOperation*> ops;
+  ElementDeleter d(&ops);
+  for (int i = 1; i <= kNumRows; i++) {
+    ops.push_back(BuildTestRow(client_table_.get(), i).release());
+  }
+  ASSERT_OK(session->ApplyBatch(&ops));
+  ASSERT_TRUE(ops.empty()) << "Successful ApplyBatch should take ownership";
+  ASSERT_FALSE(session->HasPendingOperations());
+  ASSERT_EQ(0, session->CountPendingErrors());
+  ASSERT_EQ(kNumRows + 1, CountRowsFromClient(client_table_.get()));
+}
+
 TEST_F(ClientTest, TestWriteTimeout) {
   shared_ptr<KuduSession> session = client_->NewSession();
   ASSERT_OK(session->SetFlushMode(KuduSession::MANUAL_FLUSH));
@@ -1521,6 +1767,25 @@ TEST_F(ClientTest, TestAsyncFlushResponseAfterSessionDropped) {
   ASSERT_FALSE(s.Wait().ok());
 }
 
+TEST_F(ClientTest, TestAutoFlushBackground) {
+  shared_ptr<KuduSession> session = client_->NewSession();
+  ASSERT_OK(session->SetFlushMode(KuduSession::AUTO_FLUSH_BACKGROUND));
+  ASSERT_OK(session->SetMutationBufferSpace(1024 * 1024));
+  session->SetTimeoutMillis(10000);
+
+  const int kNumRows = 100;
+  for (int i = 0; i < kNumRows; i++) {
+    ASSERT_OK(ApplyInsertToSession(session.get(), client_table_, i, i, "row"));
+  }
+
+  // The writes should drain without an explicit Flush() call.
+  while (session->HasPendingOperations()) {
+    SleepFor(MonoDelta::FromMilliseconds(10));
+  }
+  ASSERT_EQ(0, session->CountPendingErrors());
+  ASSERT_EQ(kNumRows, CountRowsFromClient(client_table_.get()));
+}
+
 TEST_F(ClientTest, TestSessionClose) {
   shared_ptr<KuduSession> session = client_->NewSession();
   ASSERT_OK(session->SetFlushMode(KuduSession::MANUAL_FLUSH));
@@ -1654,7 +1919,7 @@ void ClientTest::DoTestWriteWithDeadServer(WhichServerToKill which) {
 
 // Test error handling cases where the master is down (tablet resolution fails)
 TEST_F(ClientTest, TestWriteWithDeadMaster) {
-  client_->data_->default_admin_operation_timeout_ = MonoDelta::FromSeconds(1);
+  ClientTestAccessor::data(client_.get())->default_admin_operation_timeout_ = MonoDelta::FromSeconds(1);
   DoTestWriteWithDeadServer(DEAD_MASTER);
 }
 
@@ -1816,6 +2081,33 @@ TEST_F(ClientTest, TestMutateNonexistentRow) {
   ASSERT_EQ(0, rows.size());
 }
 
+TEST_F(ClientTest, TestOpenTableAsync) {
+  shared_ptr<KuduTable> table;
+  {
+    Synchronizer sync;
+    KuduStatusMemberCallback<Synchronizer> cb(&sync, &Synchronizer::StatusCB);
+    client_->OpenTableAsync(kTableName, &table, &cb);
+    ASSERT_OK(sync.Wait());
+  }
+  ASSERT_TRUE(table.get() != NULL);
+  ASSERT_EQ(string(kTableName), table->name());
+
+  // The table should be usable for writes despite locations being
+  // resolved lazily.
+  ASSERT_NO_FATAL_FAILURE(InsertTestRows(table.get(), 1));
+
+  // Opening a nonexistent table should report the error to the callback.
+  {
+    Synchronizer sync;
+    KuduStatusMemberCallback<Synchronizer> cb(&sync, &Synchronizer::StatusCB);
+    shared_ptr<KuduTable> bad_table;
+    client_->OpenTableAsync("xxx-does-not-exist", &bad_table, &cb);
+    Status s = sync.Wait();
+    ASSERT_TRUE(s.IsNotFound()) << s.ToString();
+    ASSERT_TRUE(bad_table.get() == NULL);
+  }
+}
+
 TEST_F(ClientTest, TestWriteWithBadColumn) {
   shared_ptr<KuduTable> table;
   ASSERT_OK(client_->OpenTable(kTableName, &table));
@@ -2098,7 +2390,7 @@ TEST_F(ClientTest, TestReplicatedMultiTabletTableFailover) {
   // Find the leader of the first tablet.
   Synchronizer sync;
   scoped_refptr<internal::RemoteTablet> rt;
-  client_->data_->meta_cache_->LookupTabletByKey(table.get(), "",
+  ClientTestAccessor::data(client_.get())->meta_cache_->LookupTabletByKey(table.get(), "",
                                                  MonoTime::Max(),
                                                  &rt, sync.AsStatusCallback());
   ASSERT_OK(sync.Wait());
@@ -2155,14 +2447,14 @@ TEST_F(ClientTest, TestReplicatedTabletWritesWithLeaderElection) {
   // Find the leader replica
   Synchronizer sync;
   scoped_refptr<internal::RemoteTablet> rt;
-  client_->data_->meta_cache_->LookupTabletByKey(table.get(), "",
+  ClientTestAccessor::data(client_.get())->meta_cache_->LookupTabletByKey(table.get(), "",
                                                  MonoTime::Max(),
                                                  &rt, sync.AsStatusCallback());
   ASSERT_OK(sync.Wait());
   internal::RemoteTabletServer *rts;
   set<string> blacklist;
   vector<internal::RemoteTabletServer*> candidates;
-  ASSERT_OK(client_->data_->GetTabletServer(client_.get(),
+  ASSERT_OK(ClientTestAccessor::data(client_.get())->GetTabletServer(client_.get(),
                                             rt->tablet_id(),
                                             KuduClient::LEADER_ONLY,
                                             blacklist,
@@ -2389,11 +2681,11 @@ TEST_F(ClientTest, TestSeveralRowMutatesPerBatch) {
 // Tests that master permits are properly released after a whole bunch of
 // rows are inserted.
 TEST_F(ClientTest, TestMasterLookupPermits) {
-  int initial_value = client_->data_->meta_cache_->master_lookup_sem_.GetValue();
+  int initial_value = ClientTestAccessor::data(client_.get())->meta_cache_->master_lookup_sem_.GetValue();
   ASSERT_NO_FATAL_FAILURE(InsertTestRows(client_table_.get(),
                                          FLAGS_test_scan_num_rows));
   ASSERT_EQ(initial_value,
-            client_->data_->meta_cache_->master_lookup_sem_.GetValue());
+            ClientTestAccessor::data(client_.get())->meta_cache_->master_lookup_sem_.GetValue());
 }
 
 // Define callback for deadlock simulation, as well as various helper methods.
@@ -25,10 +25,15 @@
 #include "kudu/client/callbacks.h"
 #include "kudu/client/client-internal.h"
 #include "kudu/client/client_builder-internal.h"
+#include "kudu/client/columnar_batch.h"
+#include "kudu/client/columnar_batch-internal.h"
 #include "kudu/client/error_collector.h"
 #include "kudu/client/error-internal.h"
 #include "kudu/client/meta_cache.h"
+#include "kudu/client/multi_scanner-internal.h"
 #include "kudu/client/row_result.h"
+#include "kudu/client/scan_batch.h"
+#include "kudu/client/scan_batch-internal.h"
 #include "kudu/client/scan_predicate-internal.h"
 #include "kudu/client/scanner-internal.h"
 #include "kudu/client/schema-internal.h"
@@ -176,8 +181,8 @@ KuduClientBuilder& KuduClientBuilder::master_server_addrs(const vector<string>&
   return *this;
 }
 
-KuduClientBuilder& KuduClientBuilder::add_master_server_addr(const string& addr) {
-  data_->master_server_addrs_.push_back(addr);
+KuduClientBuilder& KuduClientBuilder::add_master_server_addr(const Slice& addr) {
+  data_->master_server_addrs_.push_back(addr.ToString());
   return *this;
 }
 
@@ -191,11 +196,35 @@ KuduClientBuilder& KuduClientBuilder::default_rpc_timeout(const MonoDelta& timeo
   return *this;
 }
 
+KuduClientBuilder& KuduClientBuilder::num_reactors(int num_reactors) {
+  data_->num_reactors_ = num_reactors;
+  return *this;
+}
+
+KuduClientBuilder& KuduClientBuilder::connection_assignment_policy(
+    ConnectionAssignmentPolicy policy) {
+  data_->connection_assignment_policy_ = policy;
+  return *this;
+}
+
+KuduClientBuilder& KuduClientBuilder::tablet_locations_cache_ttl(const MonoDelta& ttl) {
+  data_->tablet_locations_cache_ttl_ = ttl;
+  return *this;
+}
+
 Status KuduClientBuilder::Build(shared_ptr<KuduClient>* client) {
   shared_ptr<KuduClient> c(new KuduClient());
 
+  if (data_->num_reactors_ <= 0) {
+    return Status::InvalidArgument("num_reactors must be positive");
+  }
+
   // Init messenger.
   MessengerBuilder builder("client");
+  builder.set_num_reactors(data_->num_reactors_);
+  builder.set_reactor_assignment_policy(
+      data_->connection_assignment_policy_ == KuduClientBuilder::ROUND_ROBIN ?
+      MessengerBuilder::ASSIGN_ROUND_ROBIN : MessengerBuilder::ASSIGN_BY_HASH);
   RETURN_NOT_OK(builder.Build(&c->data_->messenger_));
 
   c->data_->master_server_addrs_ = data_->master_server_addrs_;
@@ -209,7 +238,7 @@ Status KuduClientBuilder::Build(shared_ptr<KuduClient>* client) {
   RETURN_NOT_OK_PREPEND(c->data_->SetMasterServerProxy(c.get(), deadline),
                         "Could not locate the leader master");
 
-  c->data_->meta_cache_.reset(new MetaCache(c.get()));
+  c->data_->meta_cache_.reset(new MetaCache(c.get(), data_->tablet_locations_cache_ttl_));
   c->data_->dns_resolver_.reset(new DnsResolver());
 
   // Init local host names used for locality decisions.
@@ -232,38 +261,40 @@ KuduTableCreator* KuduClient::NewTableCreator() {
   return new KuduTableCreator(this);
 }
 
-Status KuduClient::IsCreateTableInProgress(const string& table_name,
+Status KuduClient::IsCreateTableInProgress(const Slice& table_name,
                                            bool *create_in_progress) {
   MonoTime deadline = MonoTime::Now(MonoTime::FINE);
   deadline.AddDelta(default_admin_operation_timeout());
-  return data_->IsCreateTableInProgress(this, table_name, deadline, create_in_progress);
+  return data_->IsCreateTableInProgress(this, table_name.ToString(), deadline,
+                                        create_in_progress);
 }
 
-Status KuduClient::DeleteTable(const string& table_name) {
+Status KuduClient::DeleteTable(const Slice& table_name) {
   MonoTime deadline = MonoTime::Now(MonoTime::FINE);
   deadline.AddDelta(default_admin_operation_timeout());
-  return data_->DeleteTable(this, table_name, deadline);
+  return data_->DeleteTable(this, table_name.ToString(), deadline);
 }
 
-KuduTableAlterer* KuduClient::NewTableAlterer(const string& name) {
-  return new KuduTableAlterer(this, name);
+KuduTableAlterer* KuduClient::NewTableAlterer(const Slice& name) {
+  return new KuduTableAlterer(this, name.ToString());
 }
 
-Status KuduClient::IsAlterTableInProgress(const string& table_name,
+Status KuduClient::IsAlterTableInProgress(const Slice& table_name,
                                           bool *alter_in_progress) {
   MonoTime deadline = MonoTime::Now(MonoTime::FINE);
   deadline.AddDelta(default_admin_operation_timeout());
-  return data_->IsAlterTableInProgress(this, table_name, deadline, alter_in_progress);
+  return data_->IsAlterTableInProgress(this, table_name.ToString(), deadline,
+                                       alter_in_progress);
 }
 
-Status KuduClient::GetTableSchema(const string& table_name,
+Status KuduClient::GetTableSchema(const Slice& table_name,
                                   KuduSchema* schema) {
   MonoTime deadline = MonoTime::Now(MonoTime::FINE);
   deadline.AddDelta(default_admin_operation_timeout());
   string table_id_ignored;
   PartitionSchema partition_schema;
   return data_->GetTableSchema(this,
-                               table_name,
+                               table_name.ToString(),
                                deadline,
                                schema,
                                &partition_schema,
@@ -326,11 +357,11 @@ Status KuduClient::ListTables(vector<string>* tables,
   return Status::OK();
 }
 
-Status KuduClient::TableExists(const string& table_name, bool* exists) {
+Status KuduClient::TableExists(const Slice& table_name, bool* exists) {
   std::vector<std::string> tables;
-  RETURN_NOT_OK(ListTables(&tables, table_name));
+  RETURN_NOT_OK(ListTables(&tables, table_name.ToString()));
   BOOST_FOREACH(const string& table, tables) {
-    if (table == table_name) {
+    if (table_name == Slice(table)) {
       *exists = true;
       return Status::OK();
     }
@@ -339,15 +370,16 @@ Status KuduClient::TableExists(const string& table_name, bool* exists) {
   return Status::OK();
 }
 
-Status KuduClient::OpenTable(const string& table_name,
+Status KuduClient::OpenTable(const Slice& table_name,
                              shared_ptr<KuduTable>* table) {
+  const string table_name_str = table_name.ToString();
   KuduSchema schema;
   string table_id;
   PartitionSchema partition_schema;
   MonoTime deadline = MonoTime::Now(MonoTime::FINE);
   deadline.AddDelta(default_admin_operation_timeout());
   RETURN_NOT_OK(data_->GetTableSchema(this,
-                                      table_name,
+                                      table_name_str,
                                       deadline,
                                       &schema,
                                       &partition_schema,
@@ -355,7 +387,7 @@ Status KuduClient::OpenTable(const string& table_name,
 
   // In the future, probably will look up the table in some map to reuse KuduTable
   // instances.
-  shared_ptr<KuduTable> ret(new KuduTable(shared_from_this(), table_name, table_id,
+  shared_ptr<KuduTable> ret(new KuduTable(shared_from_this(), table_name_str, table_id,
                                           schema, partition_schema));
   RETURN_NOT_OK(ret->data_->Open());
   table->swap(ret);
@@ -363,6 +395,41 @@ Status KuduClient::OpenTable(const string& table_name,
   return Status::OK();
 }
 
+void KuduClient::OpenTableAsync(const Slice& table_name,
+                                shared_ptr<KuduTable>* table,
+                                KuduStatusCallback* callback) {
+  MonoTime deadline = MonoTime::Now(MonoTime::FINE);
+  deadline.AddDelta(default_admin_operation_timeout());
+
+  // Deleted by OpenTableAsyncFinished().
+  internal::OpenTableAsyncState* state =
+      new internal::OpenTableAsyncState(table_name.ToString(), table, callback);
+  data_->GetTableSchemaAsync(this,
+                             state->table_name,
+                             deadline,
+                             &state->schema,
+                             &state->partition_schema,
+                             &state->table_id,
+                             Bind(&KuduClient::OpenTableAsyncFinished,
+                                  Unretained(this), Unretained(state)));
+}
+
+void KuduClient::OpenTableAsyncFinished(internal::OpenTableAsyncState* state,
+                                        const Status& status) {
+  gscoped_ptr<internal::OpenTableAsyncState> deleter(state);
+  if (status.ok()) {
+    // Unlike OpenTable(), tablet locations are not fetched here: they are
+    // looked up through the MetaCache as the table is used.
+    shared_ptr<KuduTable> ret(new KuduTable(shared_from_this(),
+                                            state->table_name,
+                                            state->table_id,
+                                            state->schema,
+                                            state->partition_schema));
+    state->table->swap(ret);
+  }
+  state->callback->Run(status);
+}
+
 shared_ptr<KuduSession> KuduClient::NewSession() {
   shared_ptr<KuduSession> ret(new KuduSession(shared_from_this()));
   ret->data_->Init(ret);
@@ -399,8 +466,8 @@ KuduTableCreator::~KuduTableCreator() {
   delete data_;
 }
 
-KuduTableCreator& KuduTableCreator::table_name(const string& name) {
-  data_->table_name_ = name;
+KuduTableCreator& KuduTableCreator::table_name(const Slice& name) {
+  data_->table_name_ = name.ToString();
   return *this;
 }
 
@@ -535,15 +602,15 @@ const KuduSchema& KuduTable::schema() const {
 }
 
 KuduInsert* KuduTable::NewInsert() {
-  return new KuduInsert(shared_from_this());
+  return KuduInsert::NewWithInlineRow(shared_from_this());
 }
 
 KuduUpdate* KuduTable::NewUpdate() {
-  return new KuduUpdate(shared_from_this());
+  return KuduUpdate::NewWithInlineRow(shared_from_this());
 }
 
 KuduDelete* KuduTable::NewDelete() {
-  return new KuduDelete(shared_from_this());
+  return KuduDelete::NewWithInlineRow(shared_from_this());
 }
 
 KuduClient* KuduTable::client() const {
@@ -636,6 +703,18 @@ Status KuduSession::SetFlushMode(FlushMode m) {
   return Status::OK();
 }
 
+Status KuduSession::SetMutationBufferSpace(size_t size) {
+  if (size == 0) {
+    return Status::InvalidArgument("Buffer size must be above zero");
+  }
+  if (data_->batcher_->HasPendingOperations()) {
+    return Status::IllegalState("Cannot change the buffer size when writes are buffered");
+  }
+  data_->mutation_buffer_space_ = size;
+  data_->batcher_->SetMaxBufferSize(size);
+  return Status::OK();
+}
+
 void KuduSession::SetTimeoutMillis(int millis) {
   CHECK_GE(millis, 0);
   data_->timeout_ms_ = millis;
@@ -650,8 +729,6 @@ Status KuduSession::Flush() {
 }
 
 void KuduSession::FlushAsync(KuduStatusCallback* user_callback) {
-  CHECK_EQ(data_->flush_mode_, MANUAL_FLUSH) << "TODO: handle other flush modes";
-
   // Swap in a new batcher to start building the next batch.
   // Save off the old batcher.
   scoped_refptr<Batcher> old_batcher;
@@ -695,9 +772,38 @@ Status KuduSession::Apply(KuduWriteOperation* write_op) {
     return s;
   }
 
-  if (data_->flush_mode_ == AUTO_FLUSH_SYNC) {
+  // AUTO_FLUSH_SYNC is the default mode and the common case on this path;
+  // hint it for the benefit of non-PGO builds.
+  if (PREDICT_TRUE(data_->flush_mode_ == AUTO_FLUSH_SYNC)) {
     return Flush();
   }
+  if (data_->flush_mode_ == AUTO_FLUSH_BACKGROUND) {
+    data_->CheckBackgroundFlush(shared_from_this());
+  }
+
+  return Status::OK();
+}
+
+Status KuduSession::ApplyBatch(vector<KuduWriteOperation*>* write_ops) {
+  // Validate before applying anything so that failure never leaves the
+  // group partially applied.
+  BOOST_FOREACH(KuduWriteOperation* write_op, *write_ops) {
+    if (!write_op->row().IsKeySet()) {
+      return Status::IllegalState("Key not specified", write_op->ToString());
+    }
+  }
+
+  RETURN_NOT_OK(data_->batcher_->Add(*write_ops));
+  write_ops->clear();
+
+  // AUTO_FLUSH_SYNC is the default mode and the common case on this path;
+  // hint it for the benefit of non-PGO builds.
+  if (PREDICT_TRUE(data_->flush_mode_ == AUTO_FLUSH_SYNC)) {
+    return Flush();
+  }
+  if (data_->flush_mode_ == AUTO_FLUSH_BACKGROUND) {
+    data_->CheckBackgroundFlush(shared_from_this());
+  }
 
   return Status::OK();
 }
@@ -732,28 +838,28 @@ KuduTableAlterer::~KuduTableAlterer() {
   delete data_;
 }
 
-KuduTableAlterer* KuduTableAlterer::RenameTo(const string& new_name) {
-  data_->rename_to_ = new_name;
+KuduTableAlterer* KuduTableAlterer::RenameTo(const Slice& new_name) {
+  data_->rename_to_ = new_name.ToString();
   return this;
 }
 
-KuduColumnSpec* KuduTableAlterer::AddColumn(const string& name) {
+KuduColumnSpec* KuduTableAlterer::AddColumn(const Slice& name) {
   Data::Step s = {AlterTableRequestPB::ADD_COLUMN,
-                  new KuduColumnSpec(name)};
+                  new KuduColumnSpec(name.ToString())};
   data_->steps_.push_back(s);
   return s.spec;
 }
 
-KuduColumnSpec* KuduTableAlterer::AlterColumn(const string& name) {
+KuduColumnSpec* KuduTableAlterer::AlterColumn(const Slice& name) {
   Data::Step s = {AlterTableRequestPB::ALTER_COLUMN,
-                  new KuduColumnSpec(name)};
+                  new KuduColumnSpec(name.ToString())};
   data_->steps_.push_back(s);
   return s.spec;
 }
 
-KuduTableAlterer* KuduTableAlterer::DropColumn(const string& name) {
+KuduTableAlterer* KuduTableAlterer::DropColumn(const Slice& name) {
   Data::Step s = {AlterTableRequestPB::DROP_COLUMN,
-                  new KuduColumnSpec(name)};
+                  new KuduColumnSpec(name.ToString())};
   data_->steps_.push_back(s);
   return this;
 }
@@ -1118,6 +1224,7 @@ Status KuduScanner::NextBatch(vector<KuduRowResult>* rows) {
     data_->controller_.Reset();
     data_->controller_.set_deadline(rpc_deadline);
     data_->PrepareRequest(KuduScanner::Data::CONTINUE);
+    const MonoTime rpc_start = MonoTime::Now(MonoTime::FINE);
     Status rpc_status = data_->proxy_->Scan(data_->next_req_,
                                             &data_->last_response_,
                                             &data_->controller_);
@@ -1125,6 +1232,7 @@ Status KuduScanner::NextBatch(vector<KuduRowResult>* rows) {
 
     // Success case.
     if (rpc_status.ok() && server_status.ok()) {
+      data_->ts_->RecordRpcRtt(MonoTime::Now(MonoTime::FINE).GetDeltaSince(rpc_start));
       if (data_->last_response_.has_last_primary_key()) {
         data_->last_primary_key_ = data_->last_response_.last_primary_key();
       }
@@ -1167,6 +1275,22 @@ Status KuduScanner::NextBatch(vector<KuduRowResult>* rows) {
   }
 }
 
+Status KuduScanner::NextBatch(KuduScanBatch* batch) {
+  // The batch's row vector retains its capacity across calls, so in
+  // steady state this extracts directly into already-allocated storage.
+  return NextBatch(&batch->data_->rows_);
+}
+
+Status KuduScanner::NextBatchColumnar(KuduColumnarBatch* batch) {
+  // Reuse the batch's scratch row vector for the row-wise extraction, then
+  // transpose into the batch's per-column arrays. The scratch vector and
+  // the column buffers are reused across calls, so a steady-state scan
+  // loop performs no allocation here.
+  RETURN_NOT_OK(NextBatch(&batch->data_->rows_));
+  batch->data_->ResetFromRows(*data_->projection_);
+  return Status::OK();
+}
+
 Status KuduScanner::GetCurrentServer(KuduTabletServer** server) {
   CHECK(data_->open_);
   internal::RemoteTabletServer* rts = data_->ts_;
@@ -1183,6 +1307,64 @@ Status KuduScanner::GetCurrentServer(KuduTabletServer** server) {
   return Status::OK();
 }
 
+////////////////////////////////////////////////////////////
+// KuduMultiScanner
+////////////////////////////////////////////////////////////
+
+KuduMultiScanner::KuduMultiScanner(KuduTable* table)
+  : data_(new KuduMultiScanner::Data(table)) {
+}
+
+KuduMultiScanner::~KuduMultiScanner() {
+  delete data_;
+}
+
+Status KuduMultiScanner::SetProjectedColumns(const vector<string>& col_names) {
+  if (data_->open_) {
+    return Status::IllegalState("Projection must be set before Open()");
+  }
+  data_->has_projection_ = true;
+  data_->projected_cols_ = col_names;
+  return Status::OK();
+}
+
+Status KuduMultiScanner::AddConjunctPredicate(KuduPredicate* pred) {
+  // Take ownership even if returning a bad status.
+  if (data_->open_) {
+    delete pred;
+    return Status::IllegalState("Predicate must be set before Open()");
+  }
+  data_->preds_.push_back(pred);
+  return Status::OK();
+}
+
+Status KuduMultiScanner::SetMaxConcurrentTablets(int max_tablets) {
+  if (data_->open_) {
+    return Status::IllegalState("Concurrency must be set before Open()");
+  }
+  if (max_tablets <= 0) {
+    return Status::InvalidArgument("Concurrency must be positive");
+  }
+  data_->max_concurrency_ = max_tablets;
+  return Status::OK();
+}
+
+Status KuduMultiScanner::Open() {
+  return data_->Open();
+}
+
+bool KuduMultiScanner::HasMoreRows() const {
+  return data_->HasMoreRows();
+}
+
+Status KuduMultiScanner::NextBatch(KuduScanBatch* batch) {
+  return data_->NextBatch(&batch->data_->rows_);
+}
+
+void KuduMultiScanner::Close() {
+  data_->Close();
+}
+
 KuduTabletServer::KuduTabletServer()
   : data_(NULL) {
 }
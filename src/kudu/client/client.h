@@ -16,14 +16,13 @@
 
 #include <stdint.h>
 #include <string>
-#include <tr1/memory>
 #include <tr1/unordered_set>
 #include <vector>
 
 #include "kudu/client/scan_predicate.h"
+#include "kudu/client/shared_ptr.h"
 #include "kudu/client/schema.h"
 #ifdef KUDU_HEADERS_NO_STUBS
-#include <gtest/gtest_prod.h>
 #include "kudu/gutil/macros.h"
 #include "kudu/gutil/port.h"
 #else
@@ -32,6 +31,7 @@
 #include "kudu/client/write_op.h"
 #include "kudu/util/kudu_export.h"
 #include "kudu/util/monotime.h"
+#include "kudu/util/slice.h"
 #include "kudu/util/status.h"
 
 namespace kudu {
@@ -45,8 +45,12 @@ class TsAdminClient;
 
 namespace client {
 
+class ClientTestAccessor;
+class KuduColumnarBatch;
 class KuduLoggingCallback;
+class KuduMultiScanner;
 class KuduRowResult;
+class KuduScanBatch;
 class KuduSession;
 class KuduStatusCallback;
 class KuduTable;
@@ -64,6 +68,7 @@ class MetaCache;
 class RemoteTablet;
 class RemoteTabletServer;
 class WriteRpc;
+struct OpenTableAsyncState;
 } // namespace internal
 
 // Installs a callback for internal client logging. It is invoked for a
@@ -107,6 +112,18 @@ Status KUDU_EXPORT SetInternalSignalNumber(int signum);
 // are stored in shared pointers.
 class KUDU_EXPORT KuduClientBuilder {
  public:
+  // Policy with which the client's RPC connections are assigned to
+  // reactor threads.
+  enum ConnectionAssignmentPolicy {
+    // Assign connections by a mixed hash of the remote address and port,
+    // balancing per-reactor load even when server addresses differ only
+    // in a few bits. This is the default.
+    HASHED,
+
+    // Assign connections to reactors in round-robin order.
+    ROUND_ROBIN
+  };
+
   KuduClientBuilder();
   ~KuduClientBuilder();
 
@@ -116,7 +133,7 @@ class KUDU_EXPORT KuduClientBuilder {
   KuduClientBuilder& master_server_addrs(const std::vector<std::string>& addrs);
 
   // Add an RPC address of a master. At least one master is required.
-  KuduClientBuilder& add_master_server_addr(const std::string& addr);
+  KuduClientBuilder& add_master_server_addr(const Slice& addr);
 
   // The default timeout used for administrative operations (e.g. CreateTable,
   // AlterTable, ...). Optional.
@@ -129,12 +146,40 @@ class KUDU_EXPORT KuduClientBuilder {
   // If not provided, defaults to 5s.
   KuduClientBuilder& default_rpc_timeout(const MonoDelta& timeout);
 
+  // The number of reactor threads used by the client's messenger for
+  // RPC I/O. Optional.
+  //
+  // A single client shared by many scanner or session threads can become
+  // bottlenecked on RPC I/O; raising this allows scan- and write-heavy
+  // workloads to scale with additional reactors. Must be > 0.
+  //
+  // If not provided, defaults to 16.
+  KuduClientBuilder& num_reactors(int num_reactors);
+
+  // The policy used to assign the client's connections to reactor
+  // threads. Optional.
+  //
+  // If not provided, defaults to HASHED.
+  KuduClientBuilder& connection_assignment_policy(ConnectionAssignmentPolicy policy);
+
+  // How long the client caches tablet locations before re-fetching them
+  // from the master. Optional.
+  //
+  // Scan-heavy applications against tables whose partitioning never
+  // changes can raise this to avoid periodic master round trips, while
+  // applications that add and drop partitions frequently can lower it to
+  // pick up those changes sooner.
+  //
+  // If not provided, cached locations never expire and are refreshed only
+  // when a lookup or write fails against them.
+  KuduClientBuilder& tablet_locations_cache_ttl(const MonoDelta& ttl);
+
   // Creates the client.
   //
   // The return value may indicate an error in the create operation, or a
   // misuse of the builder; in the latter case, only the last error is
   // returned.
-  Status Build(std::tr1::shared_ptr<KuduClient>* client);
+  Status Build(sp::shared_ptr<KuduClient>* client);
  private:
   class KUDU_NO_EXPORT Data;
 
@@ -168,7 +213,7 @@ class KUDU_EXPORT KuduClientBuilder {
 // as well.
 //
 // This class is thread-safe.
-class KUDU_EXPORT KuduClient : public std::tr1::enable_shared_from_this<KuduClient> {
+class KUDU_EXPORT KuduClient : public sp::enable_shared_from_this<KuduClient> {
  public:
   ~KuduClient();
 
@@ -176,19 +221,19 @@ class KUDU_EXPORT KuduClient : public std::tr1::enable_shared_from_this<KuduClie
   KuduTableCreator* NewTableCreator();
 
   // set 'create_in_progress' to true if a CreateTable operation is in-progress
-  Status IsCreateTableInProgress(const std::string& table_name,
+  Status IsCreateTableInProgress(const Slice& table_name,
                                  bool *create_in_progress);
 
-  Status DeleteTable(const std::string& table_name);
+  Status DeleteTable(const Slice& table_name);
 
   // Creates a KuduTableAlterer; it is the caller's responsibility to free it.
-  KuduTableAlterer* NewTableAlterer(const std::string& table_name);
+  KuduTableAlterer* NewTableAlterer(const Slice& table_name);
 
   // set 'alter_in_progress' to true if an AlterTable operation is in-progress
-  Status IsAlterTableInProgress(const std::string& table_name,
+  Status IsAlterTableInProgress(const Slice& table_name,
                                 bool *alter_in_progress);
 
-  Status GetTableSchema(const std::string& table_name,
+  Status GetTableSchema(const Slice& table_name,
                         KuduSchema* schema);
 
   Status ListTabletServers(std::vector<KuduTabletServer*>* tablet_servers);
@@ -202,21 +247,37 @@ class KUDU_EXPORT KuduClient : public std::tr1::enable_shared_from_this<KuduClie
   // Check if the table given by 'table_name' exists.
   //
   // 'exists' is set only on success.
-  Status TableExists(const std::string& table_name, bool* exists);
+  Status TableExists(const Slice& table_name, bool* exists);
 
   // Open the table with the given name. If the table has not been opened before
   // in this client, this will do an RPC to ensure that the table exists and
   // look up its schema.
   //
-  // TODO: should we offer an async version of this as well?
   // TODO: probably should have a configurable timeout in KuduClientBuilder?
-  Status OpenTable(const std::string& table_name,
-                   std::tr1::shared_ptr<KuduTable>* table);
+  Status OpenTable(const Slice& table_name,
+                   sp::shared_ptr<KuduTable>* table);
+
+  // Open the table with the given name asynchronously.
+  //
+  // Unlike OpenTable(), the schema lookup is issued on the messenger rather
+  // than blocking the caller, and the table's tablet locations are resolved
+  // lazily through the client's location cache on first access instead of
+  // being fetched from the master up front. This makes it suitable for use
+  // right after a create, when the caller knows the table exists and does
+  // not want to pay an extra master round trip before scanning or writing.
+  //
+  // 'callback' is invoked with the result once the lookup completes; on
+  // success, '*table' has been set. Both 'table' and 'callback' must remain
+  // valid until then. The callback may run on a reactor thread and must not
+  // block.
+  void OpenTableAsync(const Slice& table_name,
+                      sp::shared_ptr<KuduTable>* table,
+                      KuduStatusCallback* callback);
 
   // Create a new session for interacting with the cluster.
   // User is responsible for destroying the session object.
   // This is a fully local operation (no RPCs or blocking).
-  std::tr1::shared_ptr<KuduSession> NewSession();
+  sp::shared_ptr<KuduSession> NewSession();
 
   // Policy with which to choose amongst multiple replicas.
   enum ReplicaSelection {
@@ -249,6 +310,7 @@ class KUDU_EXPORT KuduClient : public std::tr1::enable_shared_from_this<KuduClie
   class KUDU_NO_EXPORT Data;
 
   friend class KuduClientBuilder;
+  friend class KuduMultiScanner;
   friend class KuduScanner;
   friend class KuduTable;
   friend class KuduTableAlterer;
@@ -261,18 +323,19 @@ class KUDU_EXPORT KuduClient : public std::tr1::enable_shared_from_this<KuduClie
   friend class internal::RemoteTabletServer;
   friend class internal::WriteRpc;
 
-  FRIEND_TEST(ClientTest, TestGetTabletServerBlacklist);
-  FRIEND_TEST(ClientTest, TestMasterDown);
-  FRIEND_TEST(ClientTest, TestMasterLookupPermits);
-  FRIEND_TEST(ClientTest, TestReplicatedMultiTabletTableFailover);
-  FRIEND_TEST(ClientTest, TestReplicatedTabletWritesWithLeaderElection);
-  FRIEND_TEST(ClientTest, TestScanFaultTolerance);
-  FRIEND_TEST(ClientTest, TestScanTimeout);
-  FRIEND_TEST(ClientTest, TestWriteWithDeadMaster);
-  FRIEND_TEST(MasterFailoverTest, DISABLED_TestPauseAfterCreateTableIssued);
+  // Tests reach the client's internals through this accessor (declared in
+  // client-test-util.h) rather than being friended individually, which
+  // would require test-framework macros in this public header.
+  friend class ClientTestAccessor;
 
   KuduClient();
 
+  // Completes an OpenTableAsync() call: constructs the KuduTable from the
+  // fetched schema and invokes the user's callback. Takes ownership of
+  // 'state'.
+  void OpenTableAsyncFinished(internal::OpenTableAsyncState* state,
+                              const Status& status);
+
   // Owned.
   Data* data_;
 
@@ -285,7 +348,7 @@ class KUDU_EXPORT KuduTableCreator {
   ~KuduTableCreator();
 
   // Sets the name to give the table. It is copied. Required.
-  KuduTableCreator& table_name(const std::string& name);
+  KuduTableCreator& table_name(const Slice& name);
 
   // Sets the schema with which to create the table. Must remain valid for
   // the lifetime of the builder. Required.
@@ -377,7 +440,7 @@ class KUDU_EXPORT KuduTableCreator {
 // and the schema fetched for introspection.
 //
 // This class is thread-safe.
-class KUDU_EXPORT KuduTable : public std::tr1::enable_shared_from_this<KuduTable> {
+class KUDU_EXPORT KuduTable : public sp::enable_shared_from_this<KuduTable> {
  public:
   ~KuduTable();
 
@@ -424,7 +487,7 @@ class KUDU_EXPORT KuduTable : public std::tr1::enable_shared_from_this<KuduTable
 
   friend class KuduClient;
 
-  KuduTable(const std::tr1::shared_ptr<KuduClient>& client,
+  KuduTable(const sp::shared_ptr<KuduClient>& client,
             const std::string& name,
             const std::string& table_id,
             const KuduSchema& schema,
@@ -449,19 +512,19 @@ class KUDU_EXPORT KuduTableAlterer {
   ~KuduTableAlterer();
 
   // Renames the table.
-  KuduTableAlterer* RenameTo(const std::string& new_name);
+  KuduTableAlterer* RenameTo(const Slice& new_name);
 
   // Adds a new column to the table.
   //
   // When adding a column, you must specify the default value of the new
   // column using KuduColumnSpec::DefaultValue(...).
-  KuduColumnSpec* AddColumn(const std::string& name);
+  KuduColumnSpec* AddColumn(const Slice& name);
 
   // Alter an existing column.
-  KuduColumnSpec* AlterColumn(const std::string& name);
+  KuduColumnSpec* AlterColumn(const Slice& name);
 
   // Drops an existing column from the table.
-  KuduTableAlterer* DropColumn(const std::string& name);
+  KuduTableAlterer* DropColumn(const Slice& name);
 
   // Set the timeout for the operation. This includes any waiting
   // after the alter has been submitted (i.e if the alter is slow
@@ -591,7 +654,7 @@ class KUDU_EXPORT KuduError {
 // concept of a Session familiar.
 //
 // This class is not thread-safe except where otherwise specified.
-class KUDU_EXPORT KuduSession : public std::tr1::enable_shared_from_this<KuduSession> {
+class KUDU_EXPORT KuduSession : public sp::enable_shared_from_this<KuduSession> {
  public:
   ~KuduSession();
 
@@ -602,18 +665,23 @@ class KUDU_EXPORT KuduSession : public std::tr1::enable_shared_from_this<KuduSes
     // has already flushed the buffer. This is the default flush mode.
     AUTO_FLUSH_SYNC,
 
-    // Apply() calls will return immediately, but the writes will be sent in
-    // the background, potentially batched together with other writes from
-    // the same session. If there is not sufficient buffer space, then Apply()
-    // may block for buffer space to be available.
+    // Apply() calls will return immediately, and the writes will be sent in
+    // the background, batched together with other writes from the same
+    // session. A batch is left open for a short coalescing window (currently
+    // 100us) after the first write is applied to it, so that closely-spaced
+    // Apply() calls share a single RPC per tablet; it is sent early if it
+    // accumulates enough operations or reaches the buffer space limit (see
+    // SetMutationBufferSpace()). If the buffer space is exhausted before the
+    // background flush catches up, then Apply() will return an error.
     //
     // Because writes are applied in the background, any errors will be stored
     // in a session-local buffer. Call CountPendingErrors() or GetPendingErrors()
     // to retrieve them.
     // TODO: provide an API for the user to specify a callback to do their own
     // error reporting.
-    // TODO: specify which threads the background activity runs on (probably the
-    // messenger IO threads?)
+    //
+    // The background flushes are triggered from the client's messenger
+    // reactor threads.
     //
     // The Flush() call can be used to block until the buffer is empty.
     AUTO_FLUSH_BACKGROUND,
@@ -635,10 +703,13 @@ class KUDU_EXPORT KuduSession : public std::tr1::enable_shared_from_this<KuduSes
   // AUTO_FLUSH_SYNC:
   //   since no buffering is done, this has no effect
   // AUTO_FLUSH_BACKGROUND:
-  //   if the buffer space is exhausted, then write calls will block until there
-  //   is space available in the buffer.
+  //   a flush is triggered as soon as the buffered writes reach this size,
+  //   rather than waiting for the coalescing window to expire. If the buffer
+  //   space is nonetheless exhausted, then write calls will return an error.
   // MANUAL_FLUSH:
   //   if the buffer space is exhausted, then write calls will return an error.
+  //
+  // REQUIRES: there should be no pending writes -- call Flush() first to ensure.
   Status SetMutationBufferSpace(size_t size) WARN_UNUSED_RESULT;
 
   // Set the timeout for writes made in this session.
@@ -669,6 +740,19 @@ class KUDU_EXPORT KuduSession : public std::tr1::enable_shared_from_this<KuduSes
   // This is thread safe.
   Status Apply(KuduWriteOperation* write_op) WARN_UNUSED_RESULT;
 
+  // Apply a group of write operations in a single call. This is semantically
+  // equivalent to calling Apply() on each operation in turn, but the session
+  // and batcher bookkeeping is done once for the whole group, amortizing
+  // per-operation lock acquisitions on high-throughput ingest paths. In
+  // AUTO_FLUSH_SYNC mode, a single flush covers the whole group.
+  //
+  // On success, ownership of the operations is transferred to the session
+  // and 'write_ops' is cleared. If a bad Status is returned, no ownership
+  // has been taken and no operations have been applied.
+  //
+  // This is thread safe.
+  Status ApplyBatch(std::vector<KuduWriteOperation*>* write_ops) WARN_UNUSED_RESULT;
+
   // Similar to the above, except never blocks. Even in the flush modes that
   // return immediately, 'cb' is triggered with the result. The callback may be
   // called by a reactor thread, or in some cases may be called inline by the
@@ -763,7 +847,7 @@ class KUDU_EXPORT KuduSession : public std::tr1::enable_shared_from_this<KuduSes
 
   friend class KuduClient;
   friend class internal::Batcher;
-  explicit KuduSession(const std::tr1::shared_ptr<KuduClient>& client);
+  explicit KuduSession(const sp::shared_ptr<KuduClient>& client);
 
   // Owned.
   Data* data_;
@@ -930,6 +1014,23 @@ class KUDU_EXPORT KuduScanner {
   // now be pointing to garbage memory.
   Status NextBatch(std::vector<KuduRowResult>* rows);
 
+  // Like the above, but populates 'batch' with the next batch of rows.
+  // The batch's storage is reused across calls, so a scan loop which
+  // keeps one KuduScanBatch alive performs no per-batch allocation. See
+  // KuduScanBatch in scan_batch.h.
+  //
+  // A call to NextBatch() invalidates all previously fetched results,
+  // including the previous contents of 'batch'.
+  Status NextBatch(KuduScanBatch* batch);
+
+  // Like NextBatch(), but populates 'batch' with the next batch of rows
+  // in columnar (structure-of-arrays) layout. See KuduColumnarBatch in
+  // columnar_batch.h.
+  //
+  // A call to NextBatchColumnar() invalidates all previously fetched
+  // results, including the previous contents of 'batch'.
+  Status NextBatchColumnar(KuduColumnarBatch* batch);
+
   // Get the KuduTabletServer that is currently handling the scan.
   // More concretely, this is the server that handled the most recent Open or NextBatch
   // RPC made by the server.
@@ -979,10 +1080,8 @@ class KUDU_EXPORT KuduScanner {
   class KUDU_NO_EXPORT Data;
   friend class kudu::tools::TsAdminClient;
 
-  FRIEND_TEST(ClientTest, TestScanCloseProxy);
-  FRIEND_TEST(ClientTest, TestScanFaultTolerance);
-  FRIEND_TEST(ClientTest, TestScanNoBlockCaching);
-  FRIEND_TEST(ClientTest, TestScanTimeout);
+  // See the note on KuduClient's ClientTestAccessor friendship.
+  friend class ClientTestAccessor;
 
   // Owned.
   Data* data_;
@@ -990,6 +1089,89 @@ class KUDU_EXPORT KuduScanner {
   DISALLOW_COPY_AND_ASSIGN(KuduScanner);
 };
 
+// A scanner which reads a whole table by scanning its tablets in
+// parallel.
+//
+// A KuduScanner works through a table one tablet at a time, so its
+// throughput is bounded by a single tablet server. KuduMultiScanner
+// fans the same logical scan out to every tablet at once, each on its
+// own worker, and hands the resulting batches to the caller as they
+// arrive. Batches from different tablets are interleaved in no
+// particular order.
+//
+// Sample usage:
+//
+//   KuduMultiScanner scanner(table.get());
+//   scanner.AddConjunctPredicate(...);
+//   RETURN_NOT_OK(scanner.Open());
+//   KuduScanBatch batch;
+//   while (scanner.HasMoreRows()) {
+//     RETURN_NOT_OK(scanner.NextBatch(&batch));
+//     ... // batch may be empty if no tablet had rows ready.
+//   }
+//
+// This class is not thread-safe: Open(), NextBatch() and Close() must
+// be called from a single thread.
+class KUDU_EXPORT KuduMultiScanner {
+ public:
+  // Initialize the scanner. The given 'table' object must remain valid
+  // for the lifetime of this scanner object.
+  explicit KuduMultiScanner(KuduTable* table);
+  ~KuduMultiScanner();
+
+  // Set the projection used for this scanner by passing the column names
+  // to read. Must be called before Open().
+  //
+  // This overrides any previous call to SetProjectedColumns.
+  Status SetProjectedColumns(const std::vector<std::string>& col_names) WARN_UNUSED_RESULT;
+
+  // Add a predicate to this scanner. The predicate is applied to every
+  // tablet scanned. Must be called before Open().
+  //
+  // The scanner takes ownership of 'pred', even if a bad Status is returned.
+  Status AddConjunctPredicate(KuduPredicate* pred) WARN_UNUSED_RESULT;
+
+  // Set the maximum number of tablets scanned concurrently. Each worker
+  // scans one tablet at a time; when there are more tablets than workers,
+  // the remaining tablets are picked up as workers finish. Must be > 0
+  // and must be called before Open().
+  //
+  // If not called, defaults to 8.
+  Status SetMaxConcurrentTablets(int max_tablets) WARN_UNUSED_RESULT;
+
+  // Look up the table's tablets and begin scanning all of them.
+  Status Open();
+
+  // Return true if there may be more batches to be fetched.
+  //
+  // Like KuduScanner::HasMoreRows(), this is true as long as some tablet
+  // has not been fully scanned, even if that tablet turns out to hold no
+  // matching rows.
+  bool HasMoreRows() const;
+
+  // Populates 'batch' with the next batch of rows from whichever tablet
+  // has one ready, blocking until a batch is available or all tablets
+  // are exhausted (in which case the batch is empty).
+  //
+  // A call to NextBatch() invalidates all previously fetched results,
+  // including the previous contents of 'batch'.
+  Status NextBatch(KuduScanBatch* batch);
+
+  // Stop the scan and release all resources, including resources on the
+  // tablet servers. Called automatically by the destructor.
+  //
+  // Like NextBatch(), this invalidates all previously fetched results.
+  void Close();
+
+ private:
+  class KUDU_NO_EXPORT Data;
+
+  // Owned.
+  Data* data_;
+
+  DISALLOW_COPY_AND_ASSIGN(KuduMultiScanner);
+};
+
 // In-memory representation of a remote tablet server.
 class KUDU_EXPORT KuduTabletServer {
  public:
@@ -20,7 +20,9 @@ namespace client {
 
 KuduClientBuilder::Data::Data()
   : default_admin_operation_timeout_(MonoDelta::FromSeconds(10)),
-    default_rpc_timeout_(MonoDelta::FromSeconds(5)) {
+    default_rpc_timeout_(MonoDelta::FromSeconds(5)),
+    num_reactors_(16),
+    connection_assignment_policy_(KuduClientBuilder::HASHED) {
 }
 
 KuduClientBuilder::Data::~Data() {
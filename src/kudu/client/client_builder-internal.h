@@ -31,6 +31,11 @@ class KuduClientBuilder::Data {
   std::vector<std::string> master_server_addrs_;
   MonoDelta default_admin_operation_timeout_;
   MonoDelta default_rpc_timeout_;
+  int num_reactors_;
+  KuduClientBuilder::ConnectionAssignmentPolicy connection_assignment_policy_;
+
+  // Uninitialized means cached tablet locations never expire.
+  MonoDelta tablet_locations_cache_ttl_;
 
   DISALLOW_COPY_AND_ASSIGN(Data);
 };
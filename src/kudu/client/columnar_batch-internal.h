@@ -0,0 +1,59 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef KUDU_CLIENT_COLUMNAR_BATCH_INTERNAL_H
+#define KUDU_CLIENT_COLUMNAR_BATCH_INTERNAL_H
+
+#include <vector>
+
+#include "kudu/client/columnar_batch.h"
+#include "kudu/client/row_result.h"
+#include "kudu/util/faststring.h"
+
+namespace kudu {
+
+class Schema;
+
+namespace client {
+
+class KuduColumnarBatch::Data {
+ public:
+  Data();
+  ~Data();
+
+  // Rebuild the per-column arrays from the row-wise results in 'rows_',
+  // which must have been extracted with projection 'projection'. The
+  // column and bitmap buffers are grown as needed and reused across
+  // calls.
+  void ResetFromRows(const Schema& projection);
+
+  // Scratch space for the row-wise results of the most recent
+  // NextBatch() call; the columnar arrays point into buffers derived
+  // from these. Reused across batches to avoid allocator churn.
+  std::vector<KuduRowResult> rows_;
+
+  int num_rows_;
+
+  // Per-column contiguous value arrays and null bitmaps, indexed by
+  // position in the projection. The bitmap entry is NULL for
+  // non-nullable columns. Owned.
+  std::vector<faststring*> column_data_;
+  std::vector<faststring*> null_bitmaps_;
+
+  DISALLOW_COPY_AND_ASSIGN(Data);
+};
+
+} // namespace client
+} // namespace kudu
+
+#endif
@@ -0,0 +1,127 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kudu/client/columnar_batch.h"
+#include "kudu/client/columnar_batch-internal.h"
+
+#include <glog/logging.h>
+#include <string.h>
+
+#include "kudu/common/schema.h"
+#include "kudu/gutil/stl_util.h"
+#include "kudu/util/bitmap.h"
+
+namespace kudu {
+namespace client {
+
+////////////////////////////////////////////////////////////
+// KuduColumnarBatch
+////////////////////////////////////////////////////////////
+
+KuduColumnarBatch::KuduColumnarBatch()
+  : data_(new KuduColumnarBatch::Data()) {
+}
+
+KuduColumnarBatch::~KuduColumnarBatch() {
+  delete data_;
+}
+
+int KuduColumnarBatch::num_rows() const {
+  return data_->num_rows_;
+}
+
+int KuduColumnarBatch::num_columns() const {
+  return data_->column_data_.size();
+}
+
+Slice KuduColumnarBatch::column_data(int col_idx) const {
+  DCHECK_GE(col_idx, 0);
+  DCHECK_LT(col_idx, static_cast<int>(data_->column_data_.size()));
+  const faststring* col = data_->column_data_[col_idx];
+  return Slice(col->data(), col->size());
+}
+
+const uint8_t* KuduColumnarBatch::null_bitmap(int col_idx) const {
+  DCHECK_GE(col_idx, 0);
+  DCHECK_LT(col_idx, static_cast<int>(data_->null_bitmaps_.size()));
+  const faststring* bitmap = data_->null_bitmaps_[col_idx];
+  return bitmap ? bitmap->data() : NULL;
+}
+
+////////////////////////////////////////////////////////////
+// KuduColumnarBatch::Data
+////////////////////////////////////////////////////////////
+
+KuduColumnarBatch::Data::Data()
+  : num_rows_(0) {
+}
+
+KuduColumnarBatch::Data::~Data() {
+  STLDeleteElements(&column_data_);
+  STLDeleteElements(&null_bitmaps_);
+}
+
+void KuduColumnarBatch::Data::ResetFromRows(const Schema& projection) {
+  int num_cols = projection.num_columns();
+
+  // Rebuild the per-column buffer vectors if the projection's shape has
+  // changed. This is keyed on the projection's contents rather than its
+  // address: a batch reused across scanners may see a new projection
+  // allocated at the address of a freed one. The value buffers are sized
+  // per call below, so only the column count and nullability matter here.
+  bool rebuild = static_cast<int>(column_data_.size()) != num_cols;
+  for (int c = 0; !rebuild && c < num_cols; c++) {
+    rebuild = (null_bitmaps_[c] != NULL) != projection.column(c).is_nullable();
+  }
+  if (rebuild) {
+    STLDeleteElements(&column_data_);
+    STLDeleteElements(&null_bitmaps_);
+    for (int c = 0; c < num_cols; c++) {
+      column_data_.push_back(new faststring());
+      null_bitmaps_.push_back(
+          projection.column(c).is_nullable() ? new faststring() : NULL);
+    }
+  }
+
+  num_rows_ = rows_.size();
+
+  // Transpose the row-wise data one column at a time. This makes a single
+  // sequential pass over each destination array, so the cost is one copy
+  // of the projected data; every subsequent column-at-a-time pass by the
+  // caller then touches only contiguous memory.
+  for (int c = 0; c < num_cols; c++) {
+    const ColumnSchema& col = projection.column(c);
+    size_t cell_size = col.type_info()->size();
+    faststring* dst = column_data_[c];
+    dst->resize(cell_size * num_rows_);
+    uint8_t* dst_cell = dst->data();
+    for (int r = 0; r < num_rows_; r++, dst_cell += cell_size) {
+      memcpy(dst_cell, rows_[r].cell(c), cell_size);
+    }
+
+    if (col.is_nullable()) {
+      faststring* bitmap = null_bitmaps_[c];
+      bitmap->resize(BitmapSize(num_rows_));
+      memset(bitmap->data(), 0, bitmap->size());
+      for (int r = 0; r < num_rows_; r++) {
+        if (rows_[r].IsNull(c)) {
+          BitmapSet(bitmap->data(), r);
+        }
+      }
+    }
+  }
+}
+
+} // namespace client
+} // namespace kudu
@@ -0,0 +1,83 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef KUDU_CLIENT_COLUMNAR_BATCH_H
+#define KUDU_CLIENT_COLUMNAR_BATCH_H
+
+#include <stdint.h>
+
+#ifdef KUDU_HEADERS_NO_STUBS
+#include "kudu/gutil/macros.h"
+#else
+#include "kudu/client/stubs.h"
+#endif
+#include "kudu/util/kudu_export.h"
+#include "kudu/util/slice.h"
+
+namespace kudu {
+namespace client {
+
+class KuduScanner;
+
+// A batch of scan results in columnar (structure-of-arrays) layout.
+//
+// Whereas KuduScanner::NextBatch() hands back one KuduRowResult per row,
+// this class exposes each projected column as a contiguous array of
+// values, which is a much better fit for consumers that process one
+// column at a time: only the bytes of the accessed column are pulled
+// into cache, and the data is laid out for vectorized processing.
+//
+// A batch is populated by KuduScanner::NextBatchColumnar() and remains
+// valid until the next call to NextBatchColumnar() or NextBatch() on the
+// same scanner, or until the batch itself is destroyed. The underlying
+// buffers are reused across batches, so a tight scan loop incurs no
+// per-batch allocation once the buffers have grown to a steady state.
+class KUDU_EXPORT KuduColumnarBatch {
+ public:
+  KuduColumnarBatch();
+  ~KuduColumnarBatch();
+
+  // Return the number of rows in the batch.
+  int num_rows() const;
+
+  // Return the number of projected columns in the batch.
+  int num_columns() const;
+
+  // Return the values of column 'col_idx' (an index into the scan
+  // projection) for all rows in the batch, as a contiguous array of
+  // num_rows() fixed-size values.
+  //
+  // For STRING and BINARY columns, the array elements are Slice objects
+  // pointing into the scanner's buffers. Cells whose null bit is set
+  // contain unspecified data and must not be interpreted.
+  Slice column_data(int col_idx) const;
+
+  // Return the null bitmap of column 'col_idx', or NULL if the column is
+  // not nullable. Bit 'i' (in the ordering of util/bitmap.h) is set if
+  // the value of row 'i' is NULL.
+  const uint8_t* null_bitmap(int col_idx) const;
+
+ private:
+  class KUDU_NO_EXPORT Data;
+
+  friend class KuduScanner;
+
+  // Owned.
+  Data* data_;
+
+  DISALLOW_COPY_AND_ASSIGN(KuduColumnarBatch);
+};
+
+} // namespace client
+} // namespace kudu
+#endif
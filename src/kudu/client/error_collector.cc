@@ -35,6 +35,13 @@ void ErrorCollector::AddError(gscoped_ptr<KuduError> error) {
   errors_.push_back(error.release());
 }
 
+void ErrorCollector::AddErrors(std::vector<KuduError*>* errors) {
+  lock_guard<simple_spinlock> l(&lock_);
+  errors_.reserve(errors_.size() + errors->size());
+  errors_.insert(errors_.end(), errors->begin(), errors->end());
+  errors->clear();
+}
+
 int ErrorCollector::CountErrors() const {
   lock_guard<simple_spinlock> l(&lock_);
   return errors_.size();
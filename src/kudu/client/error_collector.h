@@ -36,6 +36,11 @@ class ErrorCollector : public RefCountedThreadSafe<ErrorCollector> {
 
   void AddError(gscoped_ptr<KuduError> error);
 
+  // Add a batch of errors, taking ownership of the pointers and clearing
+  // 'errors'. Cheaper than repeated AddError() calls when a whole RPC
+  // fails: the lock is taken once and the backing vector is grown once.
+  void AddErrors(std::vector<KuduError*>* errors);
+
   // See KuduSession for details.
   int CountErrors() const;
 
@@ -58,7 +58,9 @@ namespace internal {
 ////////////////////////////////////////////////////////////
 
 RemoteTabletServer::RemoteTabletServer(const master::TSInfoPB& pb)
-  : uuid_(pb.permanent_uuid()) {
+  : uuid_(pb.permanent_uuid()),
+    connection_dead_(false),
+    rtt_ewma_us_(-1) {
 
   Update(pb);
 }
@@ -127,6 +129,40 @@ void RemoteTabletServer::Update(const master::TSInfoPB& pb) {
   BOOST_FOREACH(const HostPortPB& hostport_pb, pb.rpc_addresses()) {
     rpc_hostports_.push_back(HostPort(hostport_pb.host(), hostport_pb.port()));
   }
+
+  // The master still knows about this server; optimistically assume the
+  // next connection attempt will succeed.
+  connection_dead_ = false;
+}
+
+void RemoteTabletServer::MarkConnectionDead(const Status& status) {
+  LOG(WARNING) << "Marking tablet server " << ToString() << " as unreachable: "
+               << status.ToString();
+  lock_guard<simple_spinlock> l(&lock_);
+  connection_dead_ = true;
+}
+
+bool RemoteTabletServer::connection_dead() const {
+  lock_guard<simple_spinlock> l(&lock_);
+  return connection_dead_;
+}
+
+void RemoteTabletServer::RecordRpcRtt(const MonoDelta& rtt) {
+  // Weight new samples fairly heavily so the estimate adapts quickly
+  // when a client moves or the network changes.
+  static const double kAlpha = 0.25;
+  const double sample = rtt.ToMicroseconds();
+  lock_guard<simple_spinlock> l(&lock_);
+  if (rtt_ewma_us_ < 0) {
+    rtt_ewma_us_ = sample;
+  } else {
+    rtt_ewma_us_ = kAlpha * sample + (1 - kAlpha) * rtt_ewma_us_;
+  }
+}
+
+double RemoteTabletServer::rtt_estimate_us() const {
+  lock_guard<simple_spinlock> l(&lock_);
+  return rtt_ewma_us_;
 }
 
 string RemoteTabletServer::permanent_uuid() const {
@@ -169,6 +205,12 @@ void RemoteTablet::Refresh(const TabletServerMap& tservers,
     rep.failed = false;
     replicas_.push_back(rep);
   }
+  last_refresh_time_ = MonoTime::Now(MonoTime::FINE);
+}
+
+MonoTime RemoteTablet::last_refresh_time() const {
+  lock_guard<simple_spinlock> l(&lock_);
+  return last_refresh_time_;
 }
 
 void RemoteTablet::InvalidateCachedReplicas() {
@@ -197,7 +239,7 @@ int RemoteTablet::GetNumFailedReplicas() const {
   int failed = 0;
   lock_guard<simple_spinlock> l(&lock_);
   BOOST_FOREACH(const RemoteReplica& rep, replicas_) {
-    if (rep.failed) {
+    if (rep.failed || rep.ts->connection_dead()) {
       failed++;
     }
   }
@@ -207,7 +249,8 @@ int RemoteTablet::GetNumFailedReplicas() const {
 RemoteTabletServer* RemoteTablet::LeaderTServer() const {
   lock_guard<simple_spinlock> l(&lock_);
   BOOST_FOREACH(const RemoteReplica& replica, replicas_) {
-    if (!replica.failed && replica.role == RaftPeerPB::LEADER) {
+    if (!replica.failed && !replica.ts->connection_dead() &&
+        replica.role == RaftPeerPB::LEADER) {
       return replica.ts;
     }
   }
@@ -221,7 +264,7 @@ bool RemoteTablet::HasLeader() const {
 void RemoteTablet::GetRemoteTabletServers(vector<RemoteTabletServer*>* servers) const {
   lock_guard<simple_spinlock> l(&lock_);
   BOOST_FOREACH(const RemoteReplica& replica, replicas_) {
-    if (replica.failed) {
+    if (replica.failed || replica.ts->connection_dead()) {
       continue;
     }
     servers->push_back(replica.ts);
@@ -271,15 +314,17 @@ std::string RemoteTablet::ReplicasAsStringUnlocked() const {
     strings::SubstituteAndAppend(&replicas_str, "$0 ($1, $2)",
                                 rep.ts->permanent_uuid(),
                                 RaftPeerPB::Role_Name(rep.role),
-                                rep.failed ? "FAILED" : "OK");
+                                rep.failed || rep.ts->connection_dead() ?
+                                    "FAILED" : "OK");
   }
   return replicas_str;
 }
 
 ////////////////////////////////////////////////////////////
 
-MetaCache::MetaCache(KuduClient* client)
+MetaCache::MetaCache(KuduClient* client, const MonoDelta& tablet_locations_ttl)
   : client_(client),
+    tablet_locations_ttl_(tablet_locations_ttl),
     master_lookup_sem_(50) {
 }
 
@@ -587,6 +632,13 @@ bool MetaCache::LookupTabletByKeyFastPath(const KuduTable* table,
   if ((*r)->partition().partition_key_end().compare(partition_key) > 0 ||
       (*r)->partition().partition_key_end().empty()) {
     // partition_key < partition.end OR tablet doesn't end
+    if (PREDICT_FALSE(tablet_locations_ttl_.Initialized() &&
+                      MonoTime::Now(MonoTime::FINE).GetDeltaSince(
+                          (*r)->last_refresh_time()).MoreThan(tablet_locations_ttl_))) {
+      // The entry is stale: treat it as a miss so that the slow path
+      // refreshes the locations from the master.
+      return false;
+    }
     *remote_tablet = *r;
     return true;
   }
@@ -617,17 +669,11 @@ void MetaCache::LookupTabletByID(const string& tablet_id,
 
 void MetaCache::MarkTSFailed(RemoteTabletServer* ts,
                              const Status& status) {
-  LOG(INFO) << "Marking tablet server " << ts->ToString() << " as failed.";
-  shared_lock<rw_spinlock> l(&lock_);
-
-  Status ts_status = status.CloneAndPrepend("TS failed");
-
-  // TODO: replace with a ts->tablet multimap for faster lookup?
-  BOOST_FOREACH(const TabletMap::value_type& tablet, tablets_by_id_) {
-    // We just loop on all tablets; if a tablet does not have a replica on this
-    // TS, MarkReplicaFailed() returns false and we ignore the return value.
-    tablet.second->MarkReplicaFailed(ts, ts_status);
-  }
+  // Mark the server itself rather than sweeping every cached tablet for
+  // replicas hosted by it. Replica selection checks the server's state
+  // lazily, so each tablet's next lookup skips the server and revalidates
+  // only its own locations from the master.
+  ts->MarkConnectionDead(status.CloneAndPrepend("TS failed"));
 }
 
 bool MetaCache::AcquireMasterLookupPermit() {
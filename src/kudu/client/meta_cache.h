@@ -17,6 +17,7 @@
 #define KUDU_CLIENT_META_CACHE_H
 
 #include <boost/function.hpp>
+#include <gtest/gtest_prod.h>
 #include <map>
 #include <string>
 #include <tr1/memory>
@@ -75,6 +76,27 @@ class RemoteTabletServer {
   // Requires that 'pb''s UUID matches this server.
   void Update(const master::TSInfoPB& pb);
 
+  // Mark this tablet server as unreachable. Replicas hosted by it are
+  // skipped in cache lookups until the server is next returned by the
+  // master, at which point it is optimistically considered reachable
+  // again.
+  //
+  // The provided status is used for logging.
+  void MarkConnectionDead(const Status& status);
+
+  // Return true if the server was marked unreachable and has not been
+  // revalidated since. See MarkConnectionDead().
+  bool connection_dead() const;
+
+  // Record the observed round-trip time of a successful RPC to this
+  // server. Samples feed an exponentially-weighted moving average which
+  // CLOSEST_REPLICA selection uses as the server's distance.
+  void RecordRpcRtt(const MonoDelta& rtt);
+
+  // Return the smoothed RPC round-trip estimate in microseconds, or a
+  // negative value if no RPC to this server has been timed yet.
+  double rtt_estimate_us() const;
+
   // Return the current proxy to this tablet server. Requires that RefreshProxy
   // be called prior to this.
   std::tr1::shared_ptr<tserver::TabletServerServiceProxy> proxy() const;
@@ -100,6 +122,14 @@ class RemoteTabletServer {
   std::vector<HostPort> rpc_hostports_;
   std::tr1::shared_ptr<tserver::TabletServerServiceProxy> proxy_;
 
+  // Set when a connection to this server is lost; cleared when the master
+  // next returns the server in a lookup response.
+  bool connection_dead_;
+
+  // Smoothed RPC round-trip time in microseconds, or -1 before the first
+  // sample. See RecordRpcRtt().
+  double rtt_ewma_us_;
+
   DISALLOW_COPY_AND_ASSIGN(RemoteTabletServer);
 };
 
@@ -128,6 +158,10 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
                const google::protobuf::RepeatedPtrField
                  <master::TabletLocationsPB_ReplicaPB>& replicas);
 
+  // Return the time at which this tablet's replica locations were last
+  // refreshed from the master. Uninitialized if never refreshed.
+  MonoTime last_refresh_time() const;
+
   // Mark any replicas of this tablet hosted by 'ts' as failed. They will
   // not be returned in future cache lookups.
   //
@@ -185,6 +219,9 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   mutable simple_spinlock lock_;
   std::vector<RemoteReplica> replicas_;
 
+  // When the replica locations were last refreshed from the master.
+  MonoTime last_refresh_time_;
+
   DISALLOW_COPY_AND_ASSIGN(RemoteTablet);
 };
 
@@ -195,7 +232,11 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
 class MetaCache : public RefCountedThreadSafe<MetaCache> {
  public:
   // The passed 'client' object must remain valid as long as MetaCache is alive.
-  explicit MetaCache(KuduClient* client);
+  //
+  // Cached tablet locations older than 'tablet_locations_ttl' are treated as
+  // misses and re-fetched from the master on the next lookup. If
+  // 'tablet_locations_ttl' is uninitialized, entries never expire.
+  MetaCache(KuduClient* client, const MonoDelta& tablet_locations_ttl);
   ~MetaCache();
 
   // Look up which tablet hosts the given partition key for a table. When it is
@@ -220,8 +261,9 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   void LookupTabletByID(const std::string& tablet_id,
                         scoped_refptr<RemoteTablet>* remote_tablet);
 
-  // Mark any replicas of any tablets hosted by 'ts' as failed. They will
-  // not be returned in future cache lookups.
+  // Mark 'ts' as failed. Replicas hosted by it will not be returned in
+  // future cache lookups until the server's locations are revalidated
+  // from the master. Cached tablet locations themselves are left intact.
   void MarkTSFailed(RemoteTabletServer* ts, const Status& status);
 
   // Acquire or release a permit to perform a (slow) master lookup.
@@ -256,6 +298,10 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   KuduClient* client_;
 
+  // How long cached tablet locations stay fresh. Uninitialized means that
+  // entries never expire.
+  const MonoDelta tablet_locations_ttl_;
+
   rw_spinlock lock_;
 
   // Cache of tablet servers, by UUID.
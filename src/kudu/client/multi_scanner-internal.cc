@@ -0,0 +1,221 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kudu/client/multi_scanner-internal.h"
+
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <glog/logging.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kudu/client/client-internal.h"
+#include "kudu/client/meta_cache.h"
+#include "kudu/common/partition.h"
+#include "kudu/gutil/gscoped_ptr.h"
+#include "kudu/gutil/stl_util.h"
+#include "kudu/util/async_util.h"
+#include "kudu/util/monotime.h"
+
+using std::string;
+using std::vector;
+
+namespace kudu {
+
+namespace client {
+
+using internal::RemoteTablet;
+
+KuduMultiScanner::Data::Data(KuduTable* table)
+  : table_(DCHECK_NOTNULL(table)),
+    has_projection_(false),
+    max_concurrency_(8),
+    open_(false),
+    batch_ready_(&lock_),
+    batch_consumed_(&lock_),
+    next_range_(0),
+    closing_(false),
+    consuming_(NULL) {
+}
+
+KuduMultiScanner::Data::~Data() {
+  Close();
+  STLDeleteElements(&workers_);
+  STLDeleteElements(&preds_);
+}
+
+Status KuduMultiScanner::Data::Open() {
+  CHECK(!open_) << "Scanner already open";
+
+  // Walk the table's partition key space to find the range covered by
+  // each tablet. Each lookup is served from the meta cache when possible.
+  MonoTime deadline = MonoTime::Now(MonoTime::FINE);
+  deadline.AddDelta(table_->client()->default_admin_operation_timeout());
+  string next_key;
+  while (true) {
+    scoped_refptr<RemoteTablet> tablet;
+    Synchronizer sync;
+    table_->client()->data_->meta_cache_->LookupTabletByKey(
+        table_, next_key, deadline, &tablet, sync.AsStatusCallback());
+    RETURN_NOT_OK(sync.Wait());
+    const Partition& partition = tablet->partition();
+    ranges_.push_back(std::make_pair(partition.partition_key_start(),
+                                     partition.partition_key_end()));
+    if (partition.partition_key_end().empty()) break;
+    next_key = partition.partition_key_end();
+  }
+
+  open_ = true;
+  int num_workers = std::min(max_concurrency_,
+                             static_cast<int>(ranges_.size()));
+  for (int i = 0; i < num_workers; i++) {
+    gscoped_ptr<Worker> worker(new Worker());
+    RETURN_NOT_OK(Thread::Create("multi_scanner", "scan-worker",
+                                 &KuduMultiScanner::Data::RunWorker, this,
+                                 worker.get(), &worker->thread));
+    workers_.push_back(worker.release());
+  }
+  return Status::OK();
+}
+
+void KuduMultiScanner::Data::RunWorker(Worker* worker) {
+  Status s;
+  while (true) {
+    std::pair<string, string> range;
+    {
+      MutexLock l(lock_);
+      if (closing_ || next_range_ >= ranges_.size()) break;
+      range = ranges_[next_range_++];
+    }
+    s = ScanRange(worker, range.first, range.second);
+    if (!s.ok()) break;
+  }
+  MutexLock l(lock_);
+  worker->status = s;
+  worker->state = Worker::kFinished;
+  batch_ready_.Broadcast();
+}
+
+Status KuduMultiScanner::Data::ScanRange(Worker* worker,
+                                         const string& start,
+                                         const string& end) {
+  KuduScanner scanner(table_);
+  if (has_projection_) {
+    RETURN_NOT_OK(scanner.SetProjectedColumns(projected_cols_));
+  }
+  BOOST_FOREACH(const KuduPredicate* pred, preds_) {
+    RETURN_NOT_OK(scanner.AddConjunctPredicate(pred->Clone()));
+  }
+  if (!start.empty()) {
+    RETURN_NOT_OK(scanner.AddLowerBoundPartitionKeyRaw(start));
+  }
+  if (!end.empty()) {
+    RETURN_NOT_OK(scanner.AddExclusiveUpperBoundPartitionKeyRaw(end));
+  }
+  RETURN_NOT_OK(scanner.Open());
+
+  vector<KuduRowResult> rows;
+  while (scanner.HasMoreRows()) {
+    RETURN_NOT_OK(scanner.NextBatch(&rows));
+    if (rows.empty()) continue;
+    if (!ProduceBatch(worker, &rows)) {
+      // The scan is being torn down. Destroying the scanner invalidates
+      // the handed-off batch, which is safe because Close() joins this
+      // thread before returning to the caller.
+      return Status::Aborted("scan closed");
+    }
+  }
+  return Status::OK();
+}
+
+bool KuduMultiScanner::Data::ProduceBatch(Worker* worker,
+                                          vector<KuduRowResult>* rows) {
+  MutexLock l(lock_);
+  if (closing_) return false;
+  worker->rows.swap(*rows);
+  worker->state = Worker::kReady;
+  batch_ready_.Signal();
+  // The rows are views into this worker's scanner buffers, so the scanner
+  // must not advance until the consumer has released the batch.
+  while (worker->state != Worker::kProducing && !closing_) {
+    batch_consumed_.Wait();
+  }
+  rows->clear();
+  return !closing_;
+}
+
+void KuduMultiScanner::Data::ReleaseConsumedUnlocked() {
+  if (consuming_ != NULL) {
+    consuming_->state = Worker::kProducing;
+    consuming_ = NULL;
+    batch_consumed_.Broadcast();
+  }
+}
+
+Status KuduMultiScanner::Data::NextBatch(vector<KuduRowResult>* rows) {
+  rows->clear();
+  MutexLock l(lock_);
+  CHECK(open_) << "Must Open() before calling NextBatch()";
+  ReleaseConsumedUnlocked();
+  while (true) {
+    bool all_finished = true;
+    BOOST_FOREACH(Worker* worker, workers_) {
+      if (worker->state == Worker::kReady) {
+        rows->swap(worker->rows);
+        worker->state = Worker::kConsuming;
+        consuming_ = worker;
+        return Status::OK();
+      }
+      if (worker->state == Worker::kFinished) {
+        // Surface worker failures as soon as they are seen.
+        RETURN_NOT_OK(worker->status);
+      } else {
+        all_finished = false;
+      }
+    }
+    if (all_finished) {
+      // All tablets are exhausted; leave 'rows' empty.
+      return Status::OK();
+    }
+    batch_ready_.Wait();
+  }
+}
+
+bool KuduMultiScanner::Data::HasMoreRows() const {
+  MutexLock l(lock_);
+  BOOST_FOREACH(const Worker* worker, workers_) {
+    if (worker->state != Worker::kFinished) return true;
+  }
+  return false;
+}
+
+void KuduMultiScanner::Data::Close() {
+  {
+    MutexLock l(lock_);
+    if (closing_) return;
+    closing_ = true;
+    consuming_ = NULL;
+    batch_consumed_.Broadcast();
+    batch_ready_.Broadcast();
+  }
+  BOOST_FOREACH(Worker* worker, workers_) {
+    if (worker->thread.get() != NULL) {
+      CHECK_OK(ThreadJoiner(worker->thread.get()).Join());
+    }
+  }
+}
+
+} // namespace client
+} // namespace kudu
@@ -0,0 +1,121 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef KUDU_CLIENT_MULTI_SCANNER_INTERNAL_H
+#define KUDU_CLIENT_MULTI_SCANNER_INTERNAL_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kudu/client/client.h"
+#include "kudu/gutil/macros.h"
+#include "kudu/gutil/ref_counted.h"
+#include "kudu/util/condition_variable.h"
+#include "kudu/util/mutex.h"
+#include "kudu/util/thread.h"
+
+namespace kudu {
+
+namespace client {
+
+class KuduMultiScanner::Data {
+ public:
+  explicit Data(KuduTable* table);
+  ~Data();
+
+  // Enumerate the table's tablets and start the worker threads.
+  Status Open();
+
+  bool HasMoreRows() const;
+
+  // Swap the next available batch of rows into 'rows', blocking until one
+  // is ready or all tablets are exhausted.
+  Status NextBatch(std::vector<KuduRowResult>* rows);
+
+  // Stop all workers and join their threads. Idempotent.
+  void Close();
+
+  // Configuration. Set through the public API before Open().
+  KuduTable* table_;
+  bool has_projection_;
+  std::vector<std::string> projected_cols_;
+  std::vector<KuduPredicate*> preds_; // Owned.
+  int max_concurrency_;
+  bool open_;
+
+ private:
+  // State of one worker thread. Workers pull tablet ranges off 'ranges_'
+  // and hand each fetched batch to the consumer, blocking until the
+  // consumer has moved past it: the rows are views into the worker's
+  // scanner buffers, which must not advance while the caller still reads
+  // them.
+  struct Worker {
+    enum State {
+      // Scanning; no batch available yet.
+      kProducing,
+      // 'rows' holds a batch waiting for the consumer.
+      kReady,
+      // The caller holds this worker's batch; the worker's scanner is
+      // paused until the batch is released by the next NextBatch() call.
+      kConsuming,
+      // The worker thread has exited; 'status' holds its final status.
+      kFinished
+    };
+
+    Worker() : state(kProducing) {
+    }
+
+    State state;
+    Status status;
+    std::vector<KuduRowResult> rows;
+    scoped_refptr<Thread> thread;
+  };
+
+  // Entry point of a worker thread: scan ranges until none remain.
+  void RunWorker(Worker* worker);
+
+  // Scan the single tablet covering partition keys ['start', 'end').
+  Status ScanRange(Worker* worker,
+                   const std::string& start,
+                   const std::string& end);
+
+  // Hand the contents of 'rows' to the consumer and block until released.
+  // Returns false if the scanner is being closed instead.
+  bool ProduceBatch(Worker* worker, std::vector<KuduRowResult>* rows);
+
+  // Let the producer of the batch returned by the previous NextBatch()
+  // call resume, invalidating that batch.
+  void ReleaseConsumedUnlocked();
+
+  mutable Mutex lock_;
+  ConditionVariable batch_ready_;    // Signalled by producers.
+  ConditionVariable batch_consumed_; // Signalled by the consumer.
+
+  // Partition key ranges of the table's tablets, in table order.
+  std::vector<std::pair<std::string, std::string> > ranges_;
+  size_t next_range_;
+
+  bool closing_;
+  std::vector<Worker*> workers_; // Owned.
+
+  // The worker whose batch the caller currently holds, or NULL.
+  Worker* consuming_;
+
+  DISALLOW_COPY_AND_ASSIGN(Data);
+};
+
+} // namespace client
+} // namespace kudu
+
+#endif
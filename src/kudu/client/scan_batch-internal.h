@@ -0,0 +1,42 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef KUDU_CLIENT_SCAN_BATCH_INTERNAL_H
+#define KUDU_CLIENT_SCAN_BATCH_INTERNAL_H
+
+#include <vector>
+
+#include "kudu/client/row_result.h"
+#include "kudu/client/scan_batch.h"
+
+namespace kudu {
+namespace client {
+
+class KuduScanBatch::Data {
+ public:
+  Data() {}
+  ~Data() {}
+
+  // Row views for the current batch. Cleared and refilled by
+  // KuduScanner::NextBatch(KuduScanBatch*); the vector's capacity is
+  // retained across batches.
+  std::vector<KuduRowResult> rows_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(Data);
+};
+
+} // namespace client
+} // namespace kudu
+
+#endif
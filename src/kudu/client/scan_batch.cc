@@ -0,0 +1,46 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kudu/client/scan_batch.h"
+#include "kudu/client/scan_batch-internal.h"
+
+#include <glog/logging.h>
+
+namespace kudu {
+namespace client {
+
+KuduScanBatch::KuduScanBatch()
+  : data_(new KuduScanBatch::Data()) {
+}
+
+KuduScanBatch::~KuduScanBatch() {
+  delete data_;
+}
+
+int KuduScanBatch::NumRows() const {
+  return data_->rows_.size();
+}
+
+KuduRowResult KuduScanBatch::Row(int idx) const {
+  DCHECK_GE(idx, 0);
+  DCHECK_LT(idx, NumRows());
+  return data_->rows_[idx];
+}
+
+const KuduRowResult* KuduScanBatch::data() const {
+  return data_->rows_.empty() ? NULL : &data_->rows_[0];
+}
+
+} // namespace client
+} // namespace kudu
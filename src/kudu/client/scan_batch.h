@@ -0,0 +1,69 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef KUDU_CLIENT_SCAN_BATCH_H
+#define KUDU_CLIENT_SCAN_BATCH_H
+
+#ifdef KUDU_HEADERS_NO_STUBS
+#include "kudu/gutil/macros.h"
+#else
+#include "kudu/client/stubs.h"
+#endif
+#include "kudu/client/row_result.h"
+#include "kudu/util/kudu_export.h"
+
+namespace kudu {
+namespace client {
+
+class KuduMultiScanner;
+class KuduScanner;
+
+// A batch of rows returned by KuduScanner::NextBatch(KuduScanBatch*).
+//
+// Unlike the std::vector-based NextBatch() overload, the batch owns its
+// row-result storage and reuses it across calls, so a scan loop which
+// keeps one KuduScanBatch alive performs no per-batch heap allocation
+// once the storage has grown to the size of the largest batch.
+//
+// The rows in a batch are views into the scanner's buffers and remain
+// valid until the next NextBatch() call on the scanner, or until the
+// scanner is closed or destroyed.
+class KUDU_EXPORT KuduScanBatch {
+ public:
+  KuduScanBatch();
+  ~KuduScanBatch();
+
+  // Return the number of rows in the batch.
+  int NumRows() const;
+
+  // Return a view of row 'idx' of the batch.
+  KuduRowResult Row(int idx) const;
+
+  // Return a pointer to the contiguous array of NumRows() row views.
+  const KuduRowResult* data() const;
+
+ private:
+  class KUDU_NO_EXPORT Data;
+
+  friend class KuduMultiScanner;
+  friend class KuduScanner;
+
+  // Owned.
+  Data* data_;
+
+  DISALLOW_COPY_AND_ASSIGN(KuduScanBatch);
+};
+
+} // namespace client
+} // namespace kudu
+#endif
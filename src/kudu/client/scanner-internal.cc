@@ -305,9 +305,11 @@ Status KuduScanner::Data::OpenTablet(const string& partition_key,
     CHECK(ts->proxy());
     ts_ = CHECK_NOTNULL(ts);
     proxy_ = ts->proxy();
+    const MonoTime rpc_start = MonoTime::Now(MonoTime::FINE);
     const Status rpc_status = proxy_->Scan(next_req_, &last_response_, &controller_);
     const Status server_status = CheckForErrors();
     if (rpc_status.ok() && server_status.ok()) {
+      ts_->RecordRpcRtt(MonoTime::Now(MonoTime::FINE).GetDeltaSince(rpc_start));
       scan_attempts_ = 0;
       break;
     }
@@ -14,10 +14,18 @@
 
 #include "kudu/client/session-internal.h"
 
+#include <boost/bind.hpp>
+#include <glog/logging.h>
+
 #include "kudu/client/batcher.h"
+#include "kudu/client/callbacks.h"
+#include "kudu/client/client-internal.h"
 #include "kudu/client/error_collector.h"
+#include "kudu/rpc/messenger.h"
+#include "kudu/util/monotime.h"
 
 using std::tr1::shared_ptr;
+using std::tr1::weak_ptr;
 
 namespace kudu {
 
@@ -26,11 +34,38 @@ namespace client {
 using internal::Batcher;
 using internal::ErrorCollector;
 
+namespace {
+
+// AUTO_FLUSH_BACKGROUND: flush as soon as this many operations have been
+// buffered, without waiting for the coalescing window to expire.
+const int kBackgroundFlushMaxOps = 1000;
+
+// AUTO_FLUSH_BACKGROUND: how long a batch is left open to coalesce
+// subsequent Apply() calls before it is flushed.
+const int kBackgroundFlushWindowUs = 100;
+
+// Flush callback for background flushes. The overall batch status carries
+// no extra information: per-operation failures are reported through the
+// session's error collector, so it is simply dropped.
+class IgnoreFlushStatusCB : public KuduStatusCallback {
+ public:
+  virtual void Run(const Status& status) OVERRIDE {
+    if (PREDICT_FALSE(!status.ok())) {
+      VLOG(1) << "Background flush failed: " << status.ToString();
+    }
+  }
+};
+IgnoreFlushStatusCB ignore_flush_status_cb;
+
+} // anonymous namespace
+
 KuduSession::Data::Data(const shared_ptr<KuduClient>& client)
   : client_(client),
     error_collector_(new ErrorCollector()),
     flush_mode_(AUTO_FLUSH_SYNC),
-    timeout_ms_(-1) {}
+    timeout_ms_(-1),
+    mutation_buffer_space_(7 * 1024 * 1024),
+    flush_task_pending_(false) {}
 
 KuduSession::Data::~Data() {
 }
@@ -50,6 +85,7 @@ void KuduSession::Data::NewBatcher(const shared_ptr<KuduSession>& session,
   if (timeout_ms_ != -1) {
     batcher->SetTimeoutMillis(timeout_ms_);
   }
+  batcher->SetMaxBufferSize(mutation_buffer_space_);
   batcher.swap(batcher_);
 
   if (old_batcher) {
@@ -57,6 +93,61 @@ void KuduSession::Data::NewBatcher(const shared_ptr<KuduSession>& session,
   }
 }
 
+void KuduSession::Data::CheckBackgroundFlush(const shared_ptr<KuduSession>& session) {
+  DCHECK_EQ(flush_mode_, AUTO_FLUSH_BACKGROUND);
+
+  bool flush_now = false;
+  bool schedule_flush = false;
+  {
+    lock_guard<simple_spinlock> l(&lock_);
+    if (batcher_->CountBufferedOperations() >= kBackgroundFlushMaxOps ||
+        batcher_->buffer_bytes_used() >= static_cast<int64_t>(mutation_buffer_space_)) {
+      flush_now = true;
+    } else if (!flush_task_pending_) {
+      flush_task_pending_ = true;
+      schedule_flush = true;
+    }
+  }
+
+  if (flush_now) {
+    // The batch is already as large as we want it: no point in waiting for
+    // the coalescing window to expire.
+    session->FlushAsync(&ignore_flush_status_cb);
+  } else if (schedule_flush) {
+    client_->data_->messenger_->ScheduleOnReactor(
+        boost::bind(&KuduSession::Data::RunBackgroundFlushTask,
+                    weak_ptr<KuduSession>(session), _1),
+        MonoDelta::FromMicroseconds(kBackgroundFlushWindowUs));
+  }
+}
+
+void KuduSession::Data::RunBackgroundFlushTask(const weak_ptr<KuduSession>& weak_session,
+                                               const Status& status) {
+  if (!status.ok()) {
+    // The messenger is shutting down; the batch will be flushed or aborted
+    // by whoever tears down the session.
+    return;
+  }
+  shared_ptr<KuduSession> session = weak_session.lock();
+  if (!session) {
+    return;
+  }
+  Data* data = session->data_;
+
+  bool flush = false;
+  {
+    lock_guard<simple_spinlock> l(&data->lock_);
+    data->flush_task_pending_ = false;
+    // The session may have drained and switched modes since the timer was
+    // scheduled; don't steal a manually-managed batch in that case.
+    flush = data->flush_mode_ == AUTO_FLUSH_BACKGROUND &&
+        data->batcher_->HasPendingOperations();
+  }
+  if (flush) {
+    session->FlushAsync(&ignore_flush_status_cb);
+  }
+}
+
 void KuduSession::Data::FlushFinished(Batcher* batcher) {
   lock_guard<simple_spinlock> l(&lock_);
   CHECK_EQ(flushed_batchers_.erase(batcher), 1);
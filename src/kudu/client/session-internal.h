@@ -49,6 +49,12 @@ class KuduSession::Data {
   // operations.
   Status Close(bool force);
 
+  // Called after each Apply() in AUTO_FLUSH_BACKGROUND mode. Flushes the
+  // current batch immediately if it has reached the operation count or
+  // buffer space threshold; otherwise arranges for it to be flushed once
+  // the coalescing window expires.
+  void CheckBackgroundFlush(const std::tr1::shared_ptr<KuduSession>& session);
+
   // The client that this session is associated with.
   const std::tr1::shared_ptr<KuduClient> client_;
 
@@ -77,6 +83,21 @@ class KuduSession::Data {
   // Timeout for the next batch.
   int timeout_ms_;
 
+  // Buffer space limit applied to each new batcher. See
+  // KuduSession::SetMutationBufferSpace().
+  size_t mutation_buffer_space_;
+
+  // True while a delayed background flush is scheduled on the reactor but
+  // has not yet fired. Protected by lock_.
+  bool flush_task_pending_;
+
+ private:
+  // Reactor timer callback for AUTO_FLUSH_BACKGROUND. Flushes the session's
+  // current batch if it still has buffered operations. Holds only a weak
+  // reference so an idle timer does not keep the session alive.
+  static void RunBackgroundFlushTask(const std::tr1::weak_ptr<KuduSession>& weak_session,
+                                     const Status& status);
+
   DISALLOW_COPY_AND_ASSIGN(Data);
 };
 
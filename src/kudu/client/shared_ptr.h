@@ -0,0 +1,44 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef KUDU_CLIENT_SHARED_PTR_H
+#define KUDU_CLIENT_SHARED_PTR_H
+
+// Smart pointer typedefs for externally-faced code.
+//
+// Client APIs that pass shared ownership across the library boundary
+// (KuduClient, KuduSession, KuduTable and the write operations that hold
+// table references) do so through the kudu::client::sp namespace rather
+// than naming a concrete smart pointer implementation directly.
+//
+// This gives us a single place to change the reference counting scheme.
+// The current implementation is std::tr1::shared_ptr; swapping it (for
+// example, for an intrusively counted pointer to avoid the separate
+// control block allocation and per-copy atomics) is an ABI break and may
+// only happen together with a bump of the library's major version (see
+// CLIENT_VERSION_MAJOR in src/kudu/client/CMakeLists.txt), but requires
+// no changes to API signatures.
+
+#include <tr1/memory>
+
+namespace kudu {
+namespace client {
+namespace sp {
+  using std::tr1::shared_ptr;
+  using std::tr1::weak_ptr;
+  using std::tr1::enable_shared_from_this;
+} // namespace sp
+} // namespace client
+} // namespace kudu
+
+#endif // KUDU_CLIENT_SHARED_PTR_H
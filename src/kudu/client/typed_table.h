@@ -0,0 +1,314 @@
+// Copyright 2015 Cloudera, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef KUDU_CLIENT_TYPED_TABLE_H
+#define KUDU_CLIENT_TYPED_TABLE_H
+
+#include <stdint.h>
+#include <string>
+
+#include "kudu/client/client.h"
+#include "kudu/client/schema.h"
+#include "kudu/client/write_op.h"
+#include "kudu/common/partial_row.h"
+#include "kudu/util/slice.h"
+#include "kudu/util/status.h"
+
+namespace kudu {
+namespace client {
+
+namespace internal {
+
+// Placeholder type for the unused trailing template arguments of
+// KuduTypedTable.
+struct KuduUnusedColumn {};
+
+// Maps a C++ value type to the corresponding column type and
+// KuduPartialRow setter. Only types with a specialization below may be
+// used as KuduTypedTable template arguments.
+template<typename T>
+struct TypedColumnTraits;
+
+template<>
+struct TypedColumnTraits<int8_t> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::INT8;
+  static Status Apply(KuduPartialRow* row, int col_idx, int8_t val) {
+    return row->SetInt8(col_idx, val);
+  }
+};
+
+template<>
+struct TypedColumnTraits<int16_t> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::INT16;
+  static Status Apply(KuduPartialRow* row, int col_idx, int16_t val) {
+    return row->SetInt16(col_idx, val);
+  }
+};
+
+template<>
+struct TypedColumnTraits<int32_t> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::INT32;
+  static Status Apply(KuduPartialRow* row, int col_idx, int32_t val) {
+    return row->SetInt32(col_idx, val);
+  }
+};
+
+template<>
+struct TypedColumnTraits<int64_t> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::INT64;
+  static Status Apply(KuduPartialRow* row, int col_idx, int64_t val) {
+    return row->SetInt64(col_idx, val);
+  }
+};
+
+template<>
+struct TypedColumnTraits<bool> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::BOOL;
+  static Status Apply(KuduPartialRow* row, int col_idx, bool val) {
+    return row->SetBool(col_idx, val);
+  }
+};
+
+template<>
+struct TypedColumnTraits<float> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::FLOAT;
+  static Status Apply(KuduPartialRow* row, int col_idx, float val) {
+    return row->SetFloat(col_idx, val);
+  }
+};
+
+template<>
+struct TypedColumnTraits<double> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::DOUBLE;
+  static Status Apply(KuduPartialRow* row, int col_idx, double val) {
+    return row->SetDouble(col_idx, val);
+  }
+};
+
+// STRING columns. The value is copied into the operation.
+template<>
+struct TypedColumnTraits<Slice> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::STRING;
+  static Status Apply(KuduPartialRow* row, int col_idx, const Slice& val) {
+    return row->SetStringCopy(col_idx, val);
+  }
+};
+
+template<>
+struct TypedColumnTraits<std::string> {
+  static const KuduColumnSchema::DataType kType = KuduColumnSchema::STRING;
+  static Status Apply(KuduPartialRow* row, int col_idx, const std::string& val) {
+    return row->SetStringCopy(col_idx, Slice(val));
+  }
+};
+
+// Verify that column 'col_idx' of 'schema' has the type that
+// TypedColumnTraits<T> will write.
+template<typename T>
+Status CheckTypedColumn(const KuduSchema& schema, int col_idx) {
+  if (col_idx >= static_cast<int>(schema.num_columns())) {
+    return Status::InvalidArgument("table schema has too few columns for "
+                                   "the typed template arguments");
+  }
+  KuduColumnSchema col = schema.Column(col_idx);
+  if (col.type() != TypedColumnTraits<T>::kType) {
+    return Status::InvalidArgument(
+        "type mismatch for column " + col.name() + ": table has " +
+        KuduColumnSchema::DataTypeToString(col.type()) + ", template has " +
+        KuduColumnSchema::DataTypeToString(TypedColumnTraits<T>::kType));
+  }
+  return Status::OK();
+}
+
+template<>
+inline Status CheckTypedColumn<KuduUnusedColumn>(const KuduSchema& /*schema*/,
+                                                 int /*col_idx*/) {
+  return Status::OK();
+}
+
+} // namespace internal
+
+// A typed, header-only facade over KuduTable for applications whose
+// schema is known at compile time.
+//
+// The template arguments give the C++ value types of the leading
+// columns, in schema order (see internal::TypedColumnTraits for the
+// supported types). Insert() then takes one argument per column, and
+// each column's setter call is emitted inline with a constant column
+// index, so the per-row encode path is a straight line of type-specific
+// stores rather than a runtime walk over the schema. Columns beyond the
+// template arguments are left unset and must be nullable or have
+// defaults.
+//
+// The column types are checked against the table's actual schema once,
+// at construction; check init_status() before use.
+//
+// Example:
+//   KuduTypedTable<int32_t, int32_t, Slice> typed(table.get());
+//   RETURN_NOT_OK(typed.init_status());
+//   RETURN_NOT_OK(typed.Insert(session.get(), 1, 2, Slice("hello")));
+//
+// This class is not thread-safe, but distinct instances over the same
+// KuduTable may be used concurrently.
+template<typename T0,
+         typename T1 = internal::KuduUnusedColumn,
+         typename T2 = internal::KuduUnusedColumn,
+         typename T3 = internal::KuduUnusedColumn,
+         typename T4 = internal::KuduUnusedColumn,
+         typename T5 = internal::KuduUnusedColumn,
+         typename T6 = internal::KuduUnusedColumn,
+         typename T7 = internal::KuduUnusedColumn>
+class KuduTypedTable {
+ public:
+  // The caller must ensure that 'table' outlives this object.
+  explicit KuduTypedTable(KuduTable* table)
+    : table_(table) {
+    const KuduSchema& schema = table->schema();
+    init_status_ = internal::CheckTypedColumn<T0>(schema, 0);
+    if (init_status_.ok()) init_status_ = internal::CheckTypedColumn<T1>(schema, 1);
+    if (init_status_.ok()) init_status_ = internal::CheckTypedColumn<T2>(schema, 2);
+    if (init_status_.ok()) init_status_ = internal::CheckTypedColumn<T3>(schema, 3);
+    if (init_status_.ok()) init_status_ = internal::CheckTypedColumn<T4>(schema, 4);
+    if (init_status_.ok()) init_status_ = internal::CheckTypedColumn<T5>(schema, 5);
+    if (init_status_.ok()) init_status_ = internal::CheckTypedColumn<T6>(schema, 6);
+    if (init_status_.ok()) init_status_ = internal::CheckTypedColumn<T7>(schema, 7);
+  }
+
+  // The result of checking the template arguments against the table's
+  // schema at construction time.
+  const Status& init_status() const { return init_status_; }
+
+  // Insert a row with the given column values through 'session'.
+  //
+  // One overload per arity; calling an overload whose arity does not
+  // match the template arguments fails to compile. Ownership of the
+  // underlying operation is handled internally; on error, nothing has
+  // been applied to the session.
+  Status Insert(KuduSession* session, const T0& v0) {
+    KuduInsert* insert = table_->NewInsert();
+    KuduPartialRow* row = insert->mutable_row();
+    Status s = init_status_;
+    if (s.ok()) s = internal::TypedColumnTraits<T0>::Apply(row, 0, v0);
+    return Finish(session, insert, s);
+  }
+
+  Status Insert(KuduSession* session, const T0& v0, const T1& v1) {
+    KuduInsert* insert = table_->NewInsert();
+    KuduPartialRow* row = insert->mutable_row();
+    Status s = init_status_;
+    if (s.ok()) s = internal::TypedColumnTraits<T0>::Apply(row, 0, v0);
+    if (s.ok()) s = internal::TypedColumnTraits<T1>::Apply(row, 1, v1);
+    return Finish(session, insert, s);
+  }
+
+  Status Insert(KuduSession* session, const T0& v0, const T1& v1,
+                const T2& v2) {
+    KuduInsert* insert = table_->NewInsert();
+    KuduPartialRow* row = insert->mutable_row();
+    Status s = init_status_;
+    if (s.ok()) s = internal::TypedColumnTraits<T0>::Apply(row, 0, v0);
+    if (s.ok()) s = internal::TypedColumnTraits<T1>::Apply(row, 1, v1);
+    if (s.ok()) s = internal::TypedColumnTraits<T2>::Apply(row, 2, v2);
+    return Finish(session, insert, s);
+  }
+
+  Status Insert(KuduSession* session, const T0& v0, const T1& v1,
+                const T2& v2, const T3& v3) {
+    KuduInsert* insert = table_->NewInsert();
+    KuduPartialRow* row = insert->mutable_row();
+    Status s = init_status_;
+    if (s.ok()) s = internal::TypedColumnTraits<T0>::Apply(row, 0, v0);
+    if (s.ok()) s = internal::TypedColumnTraits<T1>::Apply(row, 1, v1);
+    if (s.ok()) s = internal::TypedColumnTraits<T2>::Apply(row, 2, v2);
+    if (s.ok()) s = internal::TypedColumnTraits<T3>::Apply(row, 3, v3);
+    return Finish(session, insert, s);
+  }
+
+  Status Insert(KuduSession* session, const T0& v0, const T1& v1,
+                const T2& v2, const T3& v3, const T4& v4) {
+    KuduInsert* insert = table_->NewInsert();
+    KuduPartialRow* row = insert->mutable_row();
+    Status s = init_status_;
+    if (s.ok()) s = internal::TypedColumnTraits<T0>::Apply(row, 0, v0);
+    if (s.ok()) s = internal::TypedColumnTraits<T1>::Apply(row, 1, v1);
+    if (s.ok()) s = internal::TypedColumnTraits<T2>::Apply(row, 2, v2);
+    if (s.ok()) s = internal::TypedColumnTraits<T3>::Apply(row, 3, v3);
+    if (s.ok()) s = internal::TypedColumnTraits<T4>::Apply(row, 4, v4);
+    return Finish(session, insert, s);
+  }
+
+  Status Insert(KuduSession* session, const T0& v0, const T1& v1,
+                const T2& v2, const T3& v3, const T4& v4, const T5& v5) {
+    KuduInsert* insert = table_->NewInsert();
+    KuduPartialRow* row = insert->mutable_row();
+    Status s = init_status_;
+    if (s.ok()) s = internal::TypedColumnTraits<T0>::Apply(row, 0, v0);
+    if (s.ok()) s = internal::TypedColumnTraits<T1>::Apply(row, 1, v1);
+    if (s.ok()) s = internal::TypedColumnTraits<T2>::Apply(row, 2, v2);
+    if (s.ok()) s = internal::TypedColumnTraits<T3>::Apply(row, 3, v3);
+    if (s.ok()) s = internal::TypedColumnTraits<T4>::Apply(row, 4, v4);
+    if (s.ok()) s = internal::TypedColumnTraits<T5>::Apply(row, 5, v5);
+    return Finish(session, insert, s);
+  }
+
+  Status Insert(KuduSession* session, const T0& v0, const T1& v1,
+                const T2& v2, const T3& v3, const T4& v4, const T5& v5,
+                const T6& v6) {
+    KuduInsert* insert = table_->NewInsert();
+    KuduPartialRow* row = insert->mutable_row();
+    Status s = init_status_;
+    if (s.ok()) s = internal::TypedColumnTraits<T0>::Apply(row, 0, v0);
+    if (s.ok()) s = internal::TypedColumnTraits<T1>::Apply(row, 1, v1);
+    if (s.ok()) s = internal::TypedColumnTraits<T2>::Apply(row, 2, v2);
+    if (s.ok()) s = internal::TypedColumnTraits<T3>::Apply(row, 3, v3);
+    if (s.ok()) s = internal::TypedColumnTraits<T4>::Apply(row, 4, v4);
+    if (s.ok()) s = internal::TypedColumnTraits<T5>::Apply(row, 5, v5);
+    if (s.ok()) s = internal::TypedColumnTraits<T6>::Apply(row, 6, v6);
+    return Finish(session, insert, s);
+  }
+
+  Status Insert(KuduSession* session, const T0& v0, const T1& v1,
+                const T2& v2, const T3& v3, const T4& v4, const T5& v5,
+                const T6& v6, const T7& v7) {
+    KuduInsert* insert = table_->NewInsert();
+    KuduPartialRow* row = insert->mutable_row();
+    Status s = init_status_;
+    if (s.ok()) s = internal::TypedColumnTraits<T0>::Apply(row, 0, v0);
+    if (s.ok()) s = internal::TypedColumnTraits<T1>::Apply(row, 1, v1);
+    if (s.ok()) s = internal::TypedColumnTraits<T2>::Apply(row, 2, v2);
+    if (s.ok()) s = internal::TypedColumnTraits<T3>::Apply(row, 3, v3);
+    if (s.ok()) s = internal::TypedColumnTraits<T4>::Apply(row, 4, v4);
+    if (s.ok()) s = internal::TypedColumnTraits<T5>::Apply(row, 5, v5);
+    if (s.ok()) s = internal::TypedColumnTraits<T6>::Apply(row, 6, v6);
+    if (s.ok()) s = internal::TypedColumnTraits<T7>::Apply(row, 7, v7);
+    return Finish(session, insert, s);
+  }
+
+ private:
+  // Apply 'insert' to 'session' if 's' is OK; otherwise discard it and
+  // return 's'.
+  Status Finish(KuduSession* session, KuduInsert* insert, const Status& s) {
+    if (!s.ok()) {
+      delete insert;
+      return s;
+    }
+    return session->Apply(insert);
+  }
+
+  KuduTable* table_;
+  Status init_status_;
+};
+
+} // namespace client
+} // namespace kudu
+#endif
@@ -14,6 +14,8 @@
 
 #include "kudu/client/write_op.h"
 
+#include <new>
+
 #include "kudu/client/client.h"
 #include "kudu/common/encoded_key.h"
 #include "kudu/common/row.h"
@@ -38,8 +40,26 @@ KuduWriteOperation::KuduWriteOperation(const shared_ptr<KuduTable>& table)
     row_(table->schema().schema_) {
 }
 
+KuduWriteOperation::KuduWriteOperation(const shared_ptr<KuduTable>& table,
+                                       uint8_t* row_storage)
+  : table_(table),
+    row_(table->schema().schema_, row_storage) {
+}
+
 KuduWriteOperation::~KuduWriteOperation() {}
 
+void* KuduWriteOperation::operator new(size_t size) {
+  return ::operator new(size);
+}
+
+void KuduWriteOperation::operator delete(void* ptr) {
+  ::operator delete(ptr);
+}
+
+size_t KuduWriteOperation::RowStorageSize(const KuduTable* table) {
+  return KuduPartialRow::RequiredStorageSize(*table->schema().schema_);
+}
+
 EncodedKey* KuduWriteOperation::CreateKey() const {
   CHECK(row_.IsKeySet()) << "key must be set";
 
@@ -81,6 +101,16 @@ KuduInsert::KuduInsert(const shared_ptr<KuduTable>& table)
   : KuduWriteOperation(table) {
 }
 
+KuduInsert::KuduInsert(const shared_ptr<KuduTable>& table, uint8_t* row_storage)
+  : KuduWriteOperation(table, row_storage) {
+}
+
+KuduInsert* KuduInsert::NewWithInlineRow(const shared_ptr<KuduTable>& table) {
+  uint8_t* buf = reinterpret_cast<uint8_t*>(
+      ::operator new(sizeof(KuduInsert) + RowStorageSize(table.get())));
+  return new (buf) KuduInsert(table, buf + sizeof(KuduInsert));
+}
+
 KuduInsert::~KuduInsert() {}
 
 // Update -----------------------------------------------------------------------
@@ -89,6 +119,16 @@ KuduUpdate::KuduUpdate(const shared_ptr<KuduTable>& table)
   : KuduWriteOperation(table) {
 }
 
+KuduUpdate::KuduUpdate(const shared_ptr<KuduTable>& table, uint8_t* row_storage)
+  : KuduWriteOperation(table, row_storage) {
+}
+
+KuduUpdate* KuduUpdate::NewWithInlineRow(const shared_ptr<KuduTable>& table) {
+  uint8_t* buf = reinterpret_cast<uint8_t*>(
+      ::operator new(sizeof(KuduUpdate) + RowStorageSize(table.get())));
+  return new (buf) KuduUpdate(table, buf + sizeof(KuduUpdate));
+}
+
 KuduUpdate::~KuduUpdate() {}
 
 // Delete -----------------------------------------------------------------------
@@ -97,6 +137,16 @@ KuduDelete::KuduDelete(const shared_ptr<KuduTable>& table)
   : KuduWriteOperation(table) {
 }
 
+KuduDelete::KuduDelete(const shared_ptr<KuduTable>& table, uint8_t* row_storage)
+  : KuduWriteOperation(table, row_storage) {
+}
+
+KuduDelete* KuduDelete::NewWithInlineRow(const shared_ptr<KuduTable>& table) {
+  uint8_t* buf = reinterpret_cast<uint8_t*>(
+      ::operator new(sizeof(KuduDelete) + RowStorageSize(table.get())));
+  return new (buf) KuduDelete(table, buf + sizeof(KuduDelete));
+}
+
 KuduDelete::~KuduDelete() {}
 
 } // namespace client
@@ -15,8 +15,8 @@
 #define KUDU_CLIENT_WRITE_OP_H
 
 #include <string>
-#include <tr1/memory>
 
+#include "kudu/client/shared_ptr.h"
 #include "kudu/common/partial_row.h"
 #include "kudu/util/kudu_export.h"
 
@@ -56,11 +56,37 @@ class KUDU_EXPORT KuduWriteOperation {
   KuduPartialRow* mutable_row() { return &row_; }
 
   virtual std::string ToString() const = 0;
+
+  // Class-level allocation functions. KuduTable's factory methods allocate
+  // an operation and its row storage in a single heap block (see
+  // KuduInsert::NewWithInlineRow() and friends), so deleting an operation
+  // must free the whole block. Routing all allocation through these
+  // functions keeps new and delete paired no matter how the operation was
+  // created.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
  protected:
-  explicit KuduWriteOperation(const std::tr1::shared_ptr<KuduTable>& table);
+  explicit KuduWriteOperation(const sp::shared_ptr<KuduTable>& table);
+
+  // Variant used on the single-allocation path: the row's backing storage
+  // is at 'row_storage', within the same block as the operation itself,
+  // rather than separately heap-allocated.
+  KuduWriteOperation(const sp::shared_ptr<KuduTable>& table, uint8_t* row_storage);
+
+  // Return the number of bytes of row storage which an operation on
+  // 'table' requires.
+  static size_t RowStorageSize(const KuduTable* table);
+
+  // Placement form used by the single-allocation factories. Must be
+  // declared here since the class-level operator new above hides the
+  // global placement form.
+  static void* operator new(size_t size, void* ptr) { return ptr; }
+  static void operator delete(void* ptr, void* placement) {}
+
   virtual Type type() const = 0;
 
-  std::tr1::shared_ptr<KuduTable> const table_;
+  sp::shared_ptr<KuduTable> const table_;
   KuduPartialRow row_;
 
  private:
@@ -98,7 +124,12 @@ class KUDU_EXPORT KuduInsert : public KuduWriteOperation {
 
  private:
   friend class KuduTable;
-  explicit KuduInsert(const std::tr1::shared_ptr<KuduTable>& table);
+  explicit KuduInsert(const sp::shared_ptr<KuduTable>& table);
+  KuduInsert(const sp::shared_ptr<KuduTable>& table, uint8_t* row_storage);
+
+  // Allocate a KuduInsert and its row storage in a single heap block,
+  // saving one allocation per row on the write path.
+  static KuduInsert* NewWithInlineRow(const sp::shared_ptr<KuduTable>& table);
 };
 
 
@@ -120,7 +151,11 @@ class KUDU_EXPORT KuduUpdate : public KuduWriteOperation {
 
  private:
   friend class KuduTable;
-  explicit KuduUpdate(const std::tr1::shared_ptr<KuduTable>& table);
+  explicit KuduUpdate(const sp::shared_ptr<KuduTable>& table);
+  KuduUpdate(const sp::shared_ptr<KuduTable>& table, uint8_t* row_storage);
+
+  // See KuduInsert::NewWithInlineRow().
+  static KuduUpdate* NewWithInlineRow(const sp::shared_ptr<KuduTable>& table);
 };
 
 
@@ -141,7 +176,11 @@ class KUDU_EXPORT KuduDelete : public KuduWriteOperation {
 
  private:
   friend class KuduTable;
-  explicit KuduDelete(const std::tr1::shared_ptr<KuduTable>& table);
+  explicit KuduDelete(const sp::shared_ptr<KuduTable>& table);
+  KuduDelete(const sp::shared_ptr<KuduTable>& table, uint8_t* row_storage);
+
+  // See KuduInsert::NewWithInlineRow().
+  static KuduDelete* NewWithInlineRow(const sp::shared_ptr<KuduTable>& table);
 };
 
 } // namespace client
@@ -42,12 +42,27 @@ inline Status FindColumn(const Schema& schema, const Slice& col_name, int* idx)
 } // anonymous namespace
 
 KuduPartialRow::KuduPartialRow(const Schema* schema)
-  : schema_(schema) {
+  : schema_(schema),
+    owns_storage_(true) {
   DCHECK(schema_->initialized());
+  InitStorage(new uint8_t[RequiredStorageSize(*schema_)]);
+}
+
+KuduPartialRow::KuduPartialRow(const Schema* schema, uint8_t* storage)
+  : schema_(schema),
+    owns_storage_(false) {
+  DCHECK(schema_->initialized());
+  InitStorage(storage);
+}
+
+size_t KuduPartialRow::RequiredStorageSize(const Schema& schema) {
+  return 2 * BitmapSize(schema.num_columns()) + ContiguousRowHelper::row_size(schema);
+}
+
+void KuduPartialRow::InitStorage(uint8_t* dst) {
   size_t column_bitmap_size = BitmapSize(schema_->num_columns());
-  size_t row_size = ContiguousRowHelper::row_size(*schema);
+  size_t row_size = ContiguousRowHelper::row_size(*schema_);
 
-  uint8_t* dst = new uint8_t[2 * column_bitmap_size + row_size];
   isset_bitmap_ = dst;
   owned_strings_bitmap_ = isset_bitmap_ + column_bitmap_size;
 
@@ -66,11 +81,14 @@ KuduPartialRow::~KuduPartialRow() {
   DeallocateOwnedStrings();
   // Both the row data and bitmap came from the same allocation.
   // The bitmap is at the start of it.
-  delete [] isset_bitmap_;
+  if (owns_storage_) {
+    delete [] isset_bitmap_;
+  }
 }
 
 KuduPartialRow::KuduPartialRow(const KuduPartialRow& other)
-    : schema_(other.schema_) {
+    : schema_(other.schema_),
+      owns_storage_(true) {
   size_t column_bitmap_size = BitmapSize(schema_->num_columns());
   size_t row_size = ContiguousRowHelper::row_size(*schema_);
 
@@ -98,6 +116,7 @@ KuduPartialRow& KuduPartialRow::operator=(KuduPartialRow other) {
   std::swap(isset_bitmap_, other.isset_bitmap_);
   std::swap(owned_strings_bitmap_, other.owned_strings_bitmap_);
   std::swap(row_data_, other.row_data_);
+  std::swap(owns_storage_, other.owns_storage_);
   return *this;
 }
 
@@ -194,6 +194,23 @@ class KUDU_EXPORT KuduPartialRow {
   template<typename KeyTypeWrapper> friend struct client::SliceKeysTestSetup;
   template<typename KeyTypeWrapper> friend struct client::IntKeysTestSetup;
 
+  // Construct a row whose backing storage (bitmaps plus row data) is
+  // supplied by the caller rather than heap-allocated. 'storage' must point
+  // to at least RequiredStorageSize(*schema) bytes and must remain valid
+  // for the lifetime of this row; it is not freed on destruction.
+  //
+  // Used by client write operations to allocate the op and its row in a
+  // single block.
+  KuduPartialRow(const Schema* schema, uint8_t* storage);
+
+  // Return the number of bytes of backing storage which a row of 'schema'
+  // requires.
+  static size_t RequiredStorageSize(const Schema& schema);
+
+  // Lay out the bitmaps and row data within 'dst' and initialize them.
+  // Shared by the constructors.
+  void InitStorage(uint8_t* dst);
+
   template<typename T>
   Status Set(const Slice& col_name, const typename T::cpp_type& val,
              bool owned = false);
@@ -241,6 +258,10 @@ class KUDU_EXPORT KuduPartialRow {
   // The normal "contiguous row" format row data. Any column whose data is unset
   // or NULL can have undefined bytes.
   uint8_t* row_data_;
+
+  // Whether the storage pointed to by isset_bitmap_ was allocated by this
+  // instance (and must be freed on destruction) or supplied by the caller.
+  bool owns_storage_;
 };
 
 } // namespace kudu
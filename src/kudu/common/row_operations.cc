@@ -122,7 +122,8 @@ RowOperationsPBDecoder::RowOperationsPBDecoder(const RowOperationsPB* pb,
     dst_arena_(dst_arena),
     bm_size_(BitmapSize(client_schema_->num_columns())),
     tablet_row_size_(ContiguousRowHelper::row_size(*tablet_schema_)),
-    src_(pb->rows().data(), pb->rows().size()) {
+    src_(pb->rows().data(), pb->rows().size()),
+    identity_mapping_(false) {
 }
 
 RowOperationsPBDecoder::~RowOperationsPBDecoder() {
@@ -266,6 +267,21 @@ class ClientServerMapping {
     return client_to_tablet_.size();
   }
 
+  // Return true if every client column maps to the tablet column at the
+  // same index, i.e. the mapping is a no-op.
+  bool is_identity() const {
+    if (client_to_tablet_.size() !=
+        static_cast<size_t>(tablet_schema_->num_columns())) {
+      return false;
+    }
+    for (int i = 0; i < static_cast<int>(client_to_tablet_.size()); i++) {
+      if (client_to_tablet_[i] != i) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   // Ensure that any required (non-null, non-defaulted) columns from the
   // server side schema are found in the client-side schema. If not,
   // returns an InvalidArgument.
@@ -322,6 +338,24 @@ Status RowOperationsPBDecoder::DecodeInsert(const uint8_t* prototype_row_storage
   memcpy(tablet_row_storage, prototype_row_storage, tablet_row_size_);
   ContiguousRow tablet_row(tablet_schema_, tablet_row_storage);
 
+  // Fast path for the null bitmap: under an identity mapping the client's
+  // null bits line up with the tablet row's, so merge them branchlessly,
+  // eight columns per byte. A column takes the client's null bit if it was
+  // both set by the client and nullable; otherwise it keeps the
+  // prototype's bit (the server-side default).
+  bool null_bits_merged = false;
+  if (identity_mapping_ && client_schema_->has_nullables() &&
+      tablet_schema_->has_nullables()) {
+    uint8_t* tablet_null_map =
+        ContiguousRowHelper::null_bitmap_ptr(*tablet_schema_, tablet_row_storage);
+    for (int i = 0; i < bm_size_; i++) {
+      uint8_t merge_mask = client_isset_map[i] & nullable_bitmask_[i];
+      tablet_null_map[i] = (tablet_null_map[i] & ~merge_mask) |
+                           (client_null_map[i] & merge_mask);
+    }
+    null_bits_merged = true;
+  }
+
   // Now handle each of the columns passed by the user, replacing the defaults
   // from the prototype.
   for (int client_col_idx = 0; client_col_idx < client_schema_->num_columns(); client_col_idx++) {
@@ -335,10 +369,11 @@ Status RowOperationsPBDecoder::DecodeInsert(const uint8_t* prototype_row_storage
     if (BitmapTest(client_isset_map, client_col_idx)) {
       // If the client provided a value for this column, copy it.
 
-      // Copy null-ness, if the server side column is nullable.
+      // Copy null-ness, if the server side column is nullable and it
+      // wasn't already merged in bulk above.
       bool client_set_to_null = col.is_nullable() &&
         BitmapTest(client_null_map, client_col_idx);
-      if (col.is_nullable()) {
+      if (col.is_nullable() && !null_bits_merged) {
         tablet_row.set_null(tablet_col_idx, client_set_to_null);
       }
       // Copy the value if it's not null
@@ -537,6 +572,19 @@ Status RowOperationsPBDecoder::DecodeOperations(vector<DecodedRowOperation>* ops
   DCHECK_EQ(mapping.num_mapped(), client_schema_->num_columns());
   RETURN_NOT_OK(mapping.CheckAllRequiredColumnsPresent());
 
+  // When the client columns map one-to-one onto the tablet columns (the
+  // common case), precompute a per-byte mask of the nullable columns so
+  // that DecodeInsert() can merge null bits eight columns at a time.
+  identity_mapping_ = mapping.is_identity();
+  if (identity_mapping_ && tablet_schema_->has_nullables()) {
+    nullable_bitmask_.assign(bm_size_, 0);
+    for (int i = 0; i < tablet_schema_->num_columns(); i++) {
+      if (tablet_schema_->column(i).is_nullable()) {
+        BitmapSet(&nullable_bitmask_[0], i);
+      }
+    }
+  }
+
   // Make a "prototype row" which has all the defaults filled in. We can copy
   // this to create a starting point for each row as we decode it, with
   // all the defaults in place without having to loop.
@@ -102,6 +102,15 @@ class RowOperationsPBDecoder {
   const int tablet_row_size_;
   Slice src_;
 
+  // True if every client column maps to the tablet column at the same
+  // index. Set up by DecodeOperations().
+  bool identity_mapping_;
+
+  // When 'identity_mapping_' is set, bit 'i' is set iff tablet column
+  // 'i' is nullable. Used to merge client null bits into decoded rows
+  // eight columns at a time.
+  std::vector<uint8_t> nullable_bitmask_;
+
 
   DISALLOW_COPY_AND_ASSIGN(RowOperationsPBDecoder);
 };
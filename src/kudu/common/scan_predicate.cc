@@ -14,16 +14,156 @@
 
 #include "kudu/common/scan_predicate.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#include <math.h>
+#endif
 #include <string>
 
 #include "kudu/common/rowblock.h"
 #include "kudu/common/types.h"
+#include "kudu/gutil/integral_types.h"
 #include "kudu/util/bitmap.h"
 
 namespace kudu {
 
 using std::string;
 
+#ifdef __AVX2__
+namespace {
+
+// AVX2 kernels which evaluate a [lower, upper] range over the leading
+// multiple-of-8 rows of a block of non-nullable cells, clearing the bits
+// of out-of-range rows in 'bitmap'. Bits which are already clear stay
+// clear, so rows deselected by an earlier predicate need not be
+// re-checked. Each iteration produces exactly one bitmap byte, matching
+// the LSB-first bit order of util/bitmap.h.
+//
+// Each kernel returns the number of rows consumed; the caller evaluates
+// the remainder row-at-a-time.
+
+size_t EvaluateRangeInt32(const uint8_t* data, int32_t lower, int32_t upper,
+                          size_t nrows, uint8_t* bitmap) {
+  const __m256i l = _mm256_set1_epi32(lower);
+  const __m256i u = _mm256_set1_epi32(upper);
+  const __m256i* cells = reinterpret_cast<const __m256i*>(data);
+  size_t nblocks = nrows / 8;
+  for (size_t b = 0; b < nblocks; b++) {
+    __m256i v = _mm256_loadu_si256(cells + b);
+    __m256i bad = _mm256_or_si256(_mm256_cmpgt_epi32(l, v),
+                                  _mm256_cmpgt_epi32(v, u));
+    bitmap[b] &= ~_mm256_movemask_ps(_mm256_castsi256_ps(bad));
+  }
+  return nblocks * 8;
+}
+
+size_t EvaluateRangeInt64(const uint8_t* data, int64_t lower, int64_t upper,
+                          size_t nrows, uint8_t* bitmap) {
+  const __m256i l = _mm256_set1_epi64x(lower);
+  const __m256i u = _mm256_set1_epi64x(upper);
+  const __m256i* cells = reinterpret_cast<const __m256i*>(data);
+  size_t nblocks = nrows / 8;
+  for (size_t b = 0; b < nblocks; b++) {
+    // Four lanes per vector, so two vectors make up one bitmap byte.
+    __m256i v0 = _mm256_loadu_si256(cells + b * 2);
+    __m256i v1 = _mm256_loadu_si256(cells + b * 2 + 1);
+    __m256i bad0 = _mm256_or_si256(_mm256_cmpgt_epi64(l, v0),
+                                   _mm256_cmpgt_epi64(v0, u));
+    __m256i bad1 = _mm256_or_si256(_mm256_cmpgt_epi64(l, v1),
+                                   _mm256_cmpgt_epi64(v1, u));
+    bitmap[b] &= ~(_mm256_movemask_pd(_mm256_castsi256_pd(bad0)) |
+                   (_mm256_movemask_pd(_mm256_castsi256_pd(bad1)) << 4));
+  }
+  return nblocks * 8;
+}
+
+// The float/double kernels use ordered comparisons so that NaN cells
+// compare as neither below nor above the range, matching the behavior
+// of TypeInfo::Compare() in the scalar path.
+
+size_t EvaluateRangeFloat(const uint8_t* data, float lower, float upper,
+                          size_t nrows, uint8_t* bitmap) {
+  const __m256 l = _mm256_set1_ps(lower);
+  const __m256 u = _mm256_set1_ps(upper);
+  const float* cells = reinterpret_cast<const float*>(data);
+  size_t nblocks = nrows / 8;
+  for (size_t b = 0; b < nblocks; b++) {
+    __m256 v = _mm256_loadu_ps(cells + b * 8);
+    __m256 bad = _mm256_or_ps(_mm256_cmp_ps(v, l, _CMP_LT_OQ),
+                              _mm256_cmp_ps(v, u, _CMP_GT_OQ));
+    bitmap[b] &= ~_mm256_movemask_ps(bad);
+  }
+  return nblocks * 8;
+}
+
+size_t EvaluateRangeDouble(const uint8_t* data, double lower, double upper,
+                           size_t nrows, uint8_t* bitmap) {
+  const __m256d l = _mm256_set1_pd(lower);
+  const __m256d u = _mm256_set1_pd(upper);
+  const double* cells = reinterpret_cast<const double*>(data);
+  size_t nblocks = nrows / 8;
+  for (size_t b = 0; b < nblocks; b++) {
+    __m256d v0 = _mm256_loadu_pd(cells + b * 8);
+    __m256d v1 = _mm256_loadu_pd(cells + b * 8 + 4);
+    __m256d bad0 = _mm256_or_pd(_mm256_cmp_pd(v0, l, _CMP_LT_OQ),
+                                _mm256_cmp_pd(v0, u, _CMP_GT_OQ));
+    __m256d bad1 = _mm256_or_pd(_mm256_cmp_pd(v1, l, _CMP_LT_OQ),
+                                _mm256_cmp_pd(v1, u, _CMP_GT_OQ));
+    bitmap[b] &= ~(_mm256_movemask_pd(bad0) |
+                   (_mm256_movemask_pd(bad1) << 4));
+  }
+  return nblocks * 8;
+}
+
+// Dispatch to a vectorized kernel based on the column type. A missing
+// bound is widened to the extreme value of the type, which behaves
+// identically under the comparisons above. Returns the number of leading
+// rows consumed, or 0 if the type has no vectorized kernel.
+size_t EvaluateRangeVectorized(const ValueRange& range,
+                               const ColumnBlock& cblock,
+                               uint8_t* bitmap) {
+  size_t nrows = cblock.nrows();
+  switch (cblock.type_info()->type()) {
+    case INT32:
+      return EvaluateRangeInt32(
+          cblock.data(),
+          range.has_lower_bound() ?
+              *reinterpret_cast<const int32_t*>(range.lower_bound()) : kint32min,
+          range.has_upper_bound() ?
+              *reinterpret_cast<const int32_t*>(range.upper_bound()) : kint32max,
+          nrows, bitmap);
+    case INT64:
+      return EvaluateRangeInt64(
+          cblock.data(),
+          range.has_lower_bound() ?
+              *reinterpret_cast<const int64_t*>(range.lower_bound()) : kint64min,
+          range.has_upper_bound() ?
+              *reinterpret_cast<const int64_t*>(range.upper_bound()) : kint64max,
+          nrows, bitmap);
+    case FLOAT:
+      return EvaluateRangeFloat(
+          cblock.data(),
+          range.has_lower_bound() ?
+              *reinterpret_cast<const float*>(range.lower_bound()) : -INFINITY,
+          range.has_upper_bound() ?
+              *reinterpret_cast<const float*>(range.upper_bound()) : INFINITY,
+          nrows, bitmap);
+    case DOUBLE:
+      return EvaluateRangeDouble(
+          cblock.data(),
+          range.has_lower_bound() ?
+              *reinterpret_cast<const double*>(range.lower_bound()) : -INFINITY,
+          range.has_upper_bound() ?
+              *reinterpret_cast<const double*>(range.upper_bound()) : INFINITY,
+          nrows, bitmap);
+    default:
+      return 0;
+  }
+}
+
+} // anonymous namespace
+#endif // __AVX2__
+
 ValueRange::ValueRange(const TypeInfo* type,
                        const void* lower_bound,
                        const void* upper_bound)
@@ -80,7 +220,13 @@ void ColumnRangePredicate::Evaluate(RowBlock* block, SelectionVector* vec) const
       }
     }
   } else {
-    for (size_t i = 0; i < block->nrows(); i++) {
+    size_t i = 0;
+#ifdef __AVX2__
+    // Fast path: evaluate numeric columns 8 rows at a time, then fall
+    // through to the scalar loop for the remainder.
+    i = EvaluateRangeVectorized(range_, cblock, vec->mutable_bitmap());
+#endif
+    for (; i < block->nrows(); i++) {
       if (!vec->IsRowSelected(i)) continue;
       const void *cell = cblock.cell_ptr(i);
       if (!range_.ContainsCell(cell)) {
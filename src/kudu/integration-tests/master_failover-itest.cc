@@ -20,6 +20,7 @@
 
 #include "kudu/client/client.h"
 #include "kudu/client/client-internal.h"
+#include "kudu/client/client-test-util.h"
 #include "kudu/common/schema.h"
 #include "kudu/gutil/strings/substitute.h"
 #include "kudu/gutil/strings/util.h"
@@ -197,8 +198,8 @@ TEST_F(MasterFailoverTest, DISABLED_TestPauseAfterCreateTableIssued) {
 
   MonoTime deadline = MonoTime::Now(MonoTime::FINE);
   deadline.AddDelta(MonoDelta::FromSeconds(90));
-  ASSERT_OK(client_->data_->WaitForCreateTableToFinish(client_.get(),
-                                                       table_id, deadline));
+  ASSERT_OK(ClientTestAccessor::data(client_.get())->WaitForCreateTableToFinish(
+      client_.get(), table_id, deadline));
 
   ASSERT_OK(OpenTableAndScanner(table_id));
 }
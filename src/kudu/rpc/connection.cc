@@ -48,6 +48,11 @@ using strings::Substitute;
 namespace kudu {
 namespace rpc {
 
+// The maximum number of iovec entries coalesced from the front of the
+// outbound transfer queue into a single writev() call. Well under IOV_MAX
+// (typically 1024) while still covering a sizable burst of queued calls.
+static const int kMaxCoalescedWriteIovecs = 64;
+
 ///
 /// Connection
 ///
@@ -476,7 +481,6 @@ void Connection::WriteHandler(ev::io &watcher, int revents) {
   }
   DVLOG(3) << ToString() << ": writeHandler: revents = " << revents;
 
-  OutboundTransfer *transfer;
   if (outbound_transfers_.empty()) {
     LOG(WARNING) << ToString() << " got a ready-to-write callback, but there is "
       "nothing to write.";
@@ -485,23 +489,40 @@ void Connection::WriteHandler(ev::io &watcher, int revents) {
   }
 
   while (!outbound_transfers_.empty()) {
-    transfer = &(outbound_transfers_.front());
+    // Coalesce as many queued transfers as fit into a single writev()
+    // against the socket, so that a burst of small calls queued on this
+    // connection pays one kernel crossing rather than one per transfer.
+    struct iovec iov[kMaxCoalescedWriteIovecs];
+    int n_iovecs = 0;
+    BOOST_FOREACH(OutboundTransfer& t, outbound_transfers_) {
+      if (n_iovecs == kMaxCoalescedWriteIovecs) break;
+      n_iovecs += t.FillIovec(&iov[n_iovecs], kMaxCoalescedWriteIovecs - n_iovecs);
+    }
 
     last_activity_time_ = reactor_thread_->cur_time();
-    Status status = transfer->SendBuffer(socket_);
+    int32_t written = 0;
+    Status status = socket_.Writev(iov, n_iovecs, &written);
     if (PREDICT_FALSE(!status.ok())) {
-      LOG(WARNING) << ToString() << " send error: " << status.ToString();
-      reactor_thread_->DestroyConnection(this, status);
+      if (!Socket::IsTemporarySocketError(status.posix_code())) {
+        LOG(WARNING) << ToString() << " send error: " << status.ToString();
+        reactor_thread_->DestroyConnection(this, status);
+      }
       return;
     }
 
-    if (!transfer->TransferFinished()) {
-      DVLOG(3) << ToString() << ": writeHandler: xfer not finished.";
-      return;
+    // Hand the written bytes to the transfers at the front of the queue,
+    // retiring those which are now fully sent.
+    while (!outbound_transfers_.empty()) {
+      OutboundTransfer* transfer = &(outbound_transfers_.front());
+      transfer->AdvanceSent(&written);
+      if (!transfer->TransferFinished()) {
+        DVLOG(3) << ToString() << ": writeHandler: xfer not finished.";
+        return;
+      }
+      outbound_transfers_.pop_front();
+      delete transfer;
+      if (written == 0) break;
     }
-
-    outbound_transfers_.pop_front();
-    delete transfer;
   }
 
 
@@ -26,6 +26,7 @@
 #include <string>
 
 #include "kudu/gutil/gscoped_ptr.h"
+#include "kudu/gutil/hash/hash.h"
 #include "kudu/gutil/map-util.h"
 #include "kudu/gutil/stl_util.h"
 #include "kudu/gutil/strings/substitute.h"
@@ -60,7 +61,8 @@ MessengerBuilder::MessengerBuilder(const std::string &name)
     connection_keepalive_time_(MonoDelta::FromSeconds(10)),
     num_reactors_(4),
     num_negotiation_threads_(4),
-    coarse_timer_granularity_(MonoDelta::FromMilliseconds(100)) {
+    coarse_timer_granularity_(MonoDelta::FromMilliseconds(100)),
+    reactor_assignment_policy_(ASSIGN_BY_HASH) {
 }
 
 MessengerBuilder& MessengerBuilder::set_connection_keepalive_time(const MonoDelta &keepalive) {
@@ -78,6 +80,12 @@ MessengerBuilder& MessengerBuilder::set_negotiation_threads(int num_negotiation_
   return *this;
 }
 
+MessengerBuilder& MessengerBuilder::set_reactor_assignment_policy(
+    ReactorAssignmentPolicy policy) {
+  reactor_assignment_policy_ = policy;
+  return *this;
+}
+
 MessengerBuilder& MessengerBuilder::set_coarse_timer_granularity(const MonoDelta &granularity) {
   coarse_timer_granularity_ = granularity;
   return *this;
@@ -221,6 +229,8 @@ void Messenger::RegisterInboundSocket(Socket *new_socket, const Sockaddr &remote
 Messenger::Messenger(const MessengerBuilder &bld)
   : name_(bld.name_),
     closing_(false),
+    reactor_assignment_policy_(bld.reactor_assignment_policy_),
+    next_reactor_(0),
     metric_entity_(bld.metric_entity_),
     retain_self_(this) {
   for (int i = 0; i < bld.num_reactors_; i++) {
@@ -238,10 +248,16 @@ Messenger::~Messenger() {
 }
 
 Reactor* Messenger::RemoteToReactor(const Sockaddr &remote) {
-  uint32_t hashCode = remote.HashCode();
-  int reactor_idx = hashCode % reactors_.size();
-  // This is just a static partitioning; we could get a lot
-  // fancier with assigning Sockaddrs to Reactors.
+  if (reactor_assignment_policy_ == MessengerBuilder::ASSIGN_ROUND_ROBIN) {
+    return reactors_[next_reactor_.Increment() % reactors_.size()];
+  }
+  // Addresses within a cluster typically differ only in a few low bits,
+  // and taking the modulus of the raw hash directly can leave most of the
+  // reactors idle while a couple handle all of the connections. Mix the
+  // hash through a 64-bit finalizer first so that all bits of the address
+  // and port contribute to the reactor choice.
+  uint64_t mixed = Hash64NumWithSeed(remote.HashCode(), MIX64);
+  int reactor_idx = mixed % reactors_.size();
   return reactors_[reactor_idx];
 }
 
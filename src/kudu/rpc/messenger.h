@@ -27,6 +27,7 @@
 #include "kudu/gutil/gscoped_ptr.h"
 #include "kudu/gutil/ref_counted.h"
 #include "kudu/rpc/response_callback.h"
+#include "kudu/util/atomic.h"
 #include "kudu/util/locks.h"
 #include "kudu/util/metrics.h"
 #include "kudu/util/monotime.h"
@@ -70,6 +71,22 @@ class MessengerBuilder {
   friend class Messenger;
   friend class ReactorThread;
 
+  // Policy with which remote peers are assigned to reactor threads.
+  enum ReactorAssignmentPolicy {
+    // Mix the hash of the remote address and port through a 64-bit
+    // finalizer before taking the modulus over the reactor count. The
+    // raw hash of addresses in a cluster differs only in a few low bits,
+    // which can pin most connections to a small subset of the reactors.
+    //
+    // This is the default.
+    ASSIGN_BY_HASH,
+
+    // Assign remotes to reactors in round-robin order. Note that with
+    // this policy repeated calls to the same remote may be handled by
+    // different reactors, each of which maintains its own connection.
+    ASSIGN_ROUND_ROBIN
+  };
+
   explicit MessengerBuilder(const std::string &name);
 
   // Set the length of time we will keep a TCP connection will alive with no traffic.
@@ -89,6 +106,9 @@ class MessengerBuilder {
   // Set metric entity for use by RPC systems.
   MessengerBuilder &set_metric_entity(const scoped_refptr<MetricEntity>& metric_entity);
 
+  // Set the policy used to assign remote peers to reactor threads.
+  MessengerBuilder &set_reactor_assignment_policy(ReactorAssignmentPolicy policy);
+
   Status Build(std::tr1::shared_ptr<Messenger> *msgr);
 
  private:
@@ -99,6 +119,7 @@ class MessengerBuilder {
   int num_negotiation_threads_;
   MonoDelta coarse_timer_granularity_;
   scoped_refptr<MetricEntity> metric_entity_;
+  ReactorAssignmentPolicy reactor_assignment_policy_;
 };
 
 // A Messenger is a container for the reactor threads which run event loops
@@ -217,6 +238,12 @@ class Messenger {
 
   std::vector<Reactor*> reactors_;
 
+  // How remotes are mapped onto 'reactors_'.
+  const MessengerBuilder::ReactorAssignmentPolicy reactor_assignment_policy_;
+
+  // Next reactor index, used only by ASSIGN_ROUND_ROBIN.
+  AtomicInt<uint32_t> next_reactor_;
+
   gscoped_ptr<ThreadPool> negotiation_pool_;
 
   scoped_refptr<MetricEntity> metric_entity_;
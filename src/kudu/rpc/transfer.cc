@@ -17,6 +17,7 @@
 #include <boost/foreach.hpp>
 #include <stdint.h>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -140,35 +141,45 @@ Status OutboundTransfer::SendBuffer(Socket &socket) {
 
   int n_iovecs = n_payload_slices_ - cur_slice_idx_;
   struct iovec iovec[n_iovecs];
-  {
-    int offset_in_slice = cur_offset_in_slice_;
-    for (int i = 0; i < n_iovecs; i++) {
-      Slice &slice = payload_slices_[cur_slice_idx_ + i];
-      iovec[i].iov_base = slice.mutable_data() + offset_in_slice;
-      iovec[i].iov_len = slice.size() - offset_in_slice;
-
-      offset_in_slice = 0;
-    }
-  }
+  FillIovec(iovec, n_iovecs);
 
   int32_t written;
   Status status = socket.Writev(iovec, n_iovecs, &written);
   RETURN_ON_ERROR_OR_SOCKET_NOT_READY(status);
 
+  AdvanceSent(&written);
+  return Status::OK();
+}
+
+int OutboundTransfer::FillIovec(struct iovec* iov, int max) {
+  int n_iovecs = std::min<int>(n_payload_slices_ - cur_slice_idx_, max);
+  int offset_in_slice = cur_offset_in_slice_;
+  for (int i = 0; i < n_iovecs; i++) {
+    Slice &slice = payload_slices_[cur_slice_idx_ + i];
+    iov[i].iov_base = slice.mutable_data() + offset_in_slice;
+    iov[i].iov_len = slice.size() - offset_in_slice;
+
+    offset_in_slice = 0;
+  }
+  return n_iovecs;
+}
+
+void OutboundTransfer::AdvanceSent(int32_t* written) {
   // Adjust our accounting of current writer position.
   for (int i = cur_slice_idx_; i < n_payload_slices_; i++) {
     Slice &slice = payload_slices_[i];
     int rem_in_slice = slice.size() - cur_offset_in_slice_;
     DCHECK_GE(rem_in_slice, 0);
 
-    if (written >= rem_in_slice) {
+    if (*written >= rem_in_slice) {
       // Used up this entire slice, advance to the next slice.
       cur_slice_idx_++;
       cur_offset_in_slice_ = 0;
-      written -= rem_in_slice;
+      *written -= rem_in_slice;
     } else {
       // Partially used up this slice, just advance the offset within it.
-      cur_offset_in_slice_ += written;
+      cur_offset_in_slice_ += *written;
+      *written = 0;
       break;
     }
   }
@@ -180,8 +191,6 @@ Status OutboundTransfer::SendBuffer(Socket &socket) {
     DCHECK_LT(cur_slice_idx_, n_payload_slices_);
     DCHECK_LT(cur_offset_in_slice_, payload_slices_[cur_slice_idx_].size());
   }
-
-  return Status::OK();
 }
 
 bool OutboundTransfer::TransferStarted() const {
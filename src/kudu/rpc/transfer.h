@@ -20,6 +20,7 @@
 #include <boost/utility.hpp>
 #include <gflags/gflags.h>
 #include <stdint.h>
+#include <sys/uio.h>
 #include <string>
 #include <vector>
 
@@ -115,6 +116,18 @@ class OutboundTransfer : public boost::intrusive::list_base_hook<> {
   // send from our buffers into the sock
   Status SendBuffer(Socket &socket);
 
+  // Fill 'iov' with up to 'max' entries describing the not-yet-sent portion
+  // of the payload. Returns the number of entries filled. This allows the
+  // connection to coalesce several queued transfers into a single writev()
+  // call against the socket.
+  int FillIovec(struct iovec* iov, int max);
+
+  // Account for '*written' bytes having been sent from the front of the
+  // not-yet-sent payload, consuming up to the number of remaining bytes
+  // from '*written'. If this completes the transfer, the transfer-finished
+  // callback is triggered.
+  void AdvanceSent(int32_t* written);
+
   // Return true if any bytes have yet been sent.
   bool TransferStarted() const;
 
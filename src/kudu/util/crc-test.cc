@@ -55,6 +55,31 @@ TEST_F(CrcTest, TestCRC32C) {
   ASSERT_EQ(0xa9421b7, data_crc); // Known value from crcutil usage test program.
 }
 
+// Verify that the Crc32c() helper (which may use the SSE4.2 crc32
+// instruction) matches the table-driven crcutil implementation on
+// buffers of various lengths and alignments.
+TEST_F(CrcTest, TestHardwareSoftwareParity) {
+  gscoped_ptr<const uint8_t[]> data;
+  const uint8_t* buf;
+  size_t buflen;
+  GenerateBenchmarkData(&buf, &buflen);
+  data.reset(buf);
+  Crc* crc32c = GetCrc32cInstance();
+  // Check lengths around the 8-byte chunking boundaries, plus a large buffer,
+  // starting at both aligned and unaligned offsets.
+  for (int offset = 0; offset < 2; offset++) {
+    for (size_t len = 0; len < 64; len++) {
+      uint64_t expected = 0;
+      crc32c->Compute(buf + offset, len, &expected);
+      ASSERT_EQ(static_cast<uint32_t>(expected), Crc32c(buf + offset, len))
+          << "mismatch at offset " << offset << ", length " << len;
+    }
+  }
+  uint64_t expected = 0;
+  crc32c->Compute(buf, buflen, &expected);
+  ASSERT_EQ(static_cast<uint32_t>(expected), Crc32c(buf, buflen));
+}
+
 // Simple benchmark of CRC32C throughput.
 // We should expect about 8 bytes per cycle in throughput on a single core.
 TEST_F(CrcTest, BenchmarkCRC32C) {
@@ -16,6 +16,7 @@
 #include <crcutil/interface.h>
 
 #include "kudu/gutil/once.h"
+#include "kudu/gutil/port.h"
 #include "kudu/util/debug/leakcheck_disabler.h"
 
 namespace kudu {
@@ -25,11 +26,46 @@ using debug::ScopedLeakCheckDisabler;
 
 static GoogleOnceType crc32c_once = GOOGLE_ONCE_INIT;
 static Crc* crc32c_instance = NULL;
+// The hardware path relies on __builtin_cpu_supports(), which gcc grew in
+// 4.8; older supported toolchains (gcc 4.4 and up) fall back to crcutil.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#define KUDU_HAVE_HARDWARE_CRC32C 1
+#endif
+
+#ifdef KUDU_HAVE_HARDWARE_CRC32C
+static bool has_hardware_crc32c = false;
+
+// Compute CRC32C using the SSE4.2 crc32 instruction, 8 bytes at a time.
+// This uses the same polynomial, initial value and final inversion as the
+// crcutil implementation, so the two produce identical checksums.
+//
+// The target attribute lets the rest of the tree build without -msse4.2;
+// callers must only reach this after the CPU check in InitCrc32cInstance().
+__attribute__((target("sse4.2")))
+static uint32_t HardwareCrc32c(const void* data, size_t length) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  uint64_t crc = 0xFFFFFFFF;
+  while (length >= sizeof(uint64_t)) {
+    crc = __builtin_ia32_crc32di(crc, UNALIGNED_LOAD64(p));
+    p += sizeof(uint64_t);
+    length -= sizeof(uint64_t);
+  }
+  while (length > 0) {
+    crc = __builtin_ia32_crc32qi(crc, *p++);
+    length--;
+  }
+  return static_cast<uint32_t>(crc) ^ 0xFFFFFFFF;
+}
+#endif // KUDU_HAVE_HARDWARE_CRC32C
 
 static void InitCrc32cInstance() {
   ScopedLeakCheckDisabler disabler; // CRC instance is never freed.
   // TODO: Is initial = 0 and roll window = 4 appropriate for all cases?
   crc32c_instance = crcutil_interface::CRC::CreateCrc32c(true, 0, 4, NULL);
+#ifdef KUDU_HAVE_HARDWARE_CRC32C
+  has_hardware_crc32c = __builtin_cpu_supports("sse4.2");
+#endif
 }
 
 Crc* GetCrc32cInstance() {
@@ -38,8 +74,14 @@ Crc* GetCrc32cInstance() {
 }
 
 uint32_t Crc32c(const void* data, size_t length) {
+  GoogleOnceInit(&crc32c_once, &InitCrc32cInstance);
+#ifdef KUDU_HAVE_HARDWARE_CRC32C
+  if (PREDICT_TRUE(has_hardware_crc32c)) {
+    return HardwareCrc32c(data, length);
+  }
+#endif
   uint64_t crc32 = 0;
-  GetCrc32cInstance()->Compute(data, length, &crc32);
+  crc32c_instance->Compute(data, length, &crc32);
   return static_cast<uint32_t>(crc32); // Only uses lower 32 bits.
 }
 